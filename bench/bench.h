@@ -0,0 +1,85 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+// Shared timing harness for the benches. Each measurement runs one untimed
+// warm-up sample and then BENCH_SAMPLES timed ones (the BENCH_SAMPLES
+// environment variable overrides it), and prints one JSON object per line:
+//
+//   {"bench":"gameplay_update","params":"autoplay","ops":100000,"samples":20,
+//    "ns_per_op":178.04,"stddev":2.73,"min":174.06,"max":184.45}
+//
+// ns_per_op is the mean over samples and stddev their standard deviation,
+// so results can be diffed across commits with any JSON tool.
+#include <SDL.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "brick.h"
+
+#define BENCH_SAMPLES 20
+#define BENCH_MAX_SAMPLES 1000
+
+// Runs ops operations; everything it does is timed
+typedef void (*BenchRun)(void* context, int ops);
+// Untimed, before every sample, for work that mutates its input
+typedef void (*BenchSetup)(void* context);
+
+// Results go here so the compiler can't drop the work that produced them
+static volatile int bench_sink;
+
+static int bench_samples(void) {
+    const char* value = getenv("BENCH_SAMPLES");
+    int samples = value ? atoi(value) : BENCH_SAMPLES;
+    if (samples < 2) samples = 2;
+    if (samples > BENCH_MAX_SAMPLES) samples = BENCH_MAX_SAMPLES;
+    return samples;
+}
+
+// Square-ish wall of count bricks at the stage pitch, indexed
+static void bench_fill_wall(BrickGrid* grid, int count) {
+    int cols = 1;
+    while (cols * cols < count) cols++;
+    
+    brick_grid_clear(grid);
+    for (int i = 0; i < count; i++) {
+        float x = 5 + (i % cols) * 52;
+        float y = 80 + (i / cols) * 22;
+        brick_grid_add(grid, x, y, 50, 20, (BrickType)(i % BRICK_TYPES_COUNT));
+    }
+    brick_grid_build_index(grid);
+}
+
+static void bench_measure(const char* bench, const char* params, BenchSetup setup,
+                          BenchRun run, void* context, int ops) {
+    static double ns[BENCH_MAX_SAMPLES];
+    int samples = bench_samples();
+    double frequency = (double)SDL_GetPerformanceFrequency();
+    
+    for (int s = -1; s < samples; s++) {
+        if (setup) setup(context);
+        Uint64 start = SDL_GetPerformanceCounter();
+        run(context, ops);
+        Uint64 elapsed = SDL_GetPerformanceCounter() - start;
+        if (s >= 0) ns[s] = (double)elapsed * 1e9 / frequency / ops;
+    }
+    
+    double mean = 0.0, min = ns[0], max = ns[0];
+    for (int s = 0; s < samples; s++) {
+        mean += ns[s];
+        if (ns[s] < min) min = ns[s];
+        if (ns[s] > max) max = ns[s];
+    }
+    mean /= samples;
+    double variance = 0.0;
+    for (int s = 0; s < samples; s++) {
+        variance += (ns[s] - mean) * (ns[s] - mean);
+    }
+    variance /= samples - 1;
+    
+    printf("{\"bench\":\"%s\",\"params\":\"%s\",\"ops\":%d,\"samples\":%d,"
+           "\"ns_per_op\":%.2f,\"stddev\":%.2f,\"min\":%.2f,\"max\":%.2f}\n",
+           bench, params, ops, samples, mean, sqrt(variance), min, max);
+    fflush(stdout);
+}
+
+#endif
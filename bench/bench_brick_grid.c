@@ -0,0 +1,84 @@
+#include "bench.h"
+#include "brick.h"
+#include <string.h>
+
+// Brick counts to measure
+static const int brick_counts[] = {100, 1000, 4000, 16000};
+#define QUERIES 20000
+
+static BrickGrid grid;
+
+typedef struct {
+    float origin_x, origin_y;
+    float span_x, span_y;
+    int hits;
+} SweepArea;
+
+static SweepArea area_of_index(void) {
+    BrickIndex* index = &grid.index;
+    SweepArea area = {index->origin_x, index->origin_y,
+                      index->cols * index->cell_width, index->rows * index->cell_height, 0};
+    return area;
+}
+
+// Random short sweeps over the wall area
+static void run_queries(void* context, int ops) {
+    SweepArea* area = context;
+    srand(1234);
+    area->hits = 0;
+    for (int q = 0; q < ops; q++) {
+        float x = area->origin_x + (rand() % 1000) / 1000.0f * area->span_x;
+        float y = area->origin_y + (rand() % 1000) / 1000.0f * area->span_y;
+        float move_x = (rand() % 21 - 10) * 0.2f;
+        float move_y = (rand() % 21 - 10) * 0.2f;
+        
+        BrickHit hit;
+        if (brick_grid_sweep(&grid, x, y, 16, 16, move_x, move_y, &hit)) {
+            area->hits++;
+        }
+    }
+    bench_sink = area->hits;
+}
+
+int main(void) {
+    const Texture* textures[BRICK_TYPES_COUNT];
+    memset(textures, 0, sizeof(textures));
+    brick_grid_init(&grid, textures);
+    char params[64];
+    
+    for (size_t i = 0; i < sizeof(brick_counts) / sizeof(brick_counts[0]); i++) {
+        bench_fill_wall(&grid, brick_counts[i]);
+        SweepArea area = area_of_index();
+        
+        // Dropping the index makes every query scan all bricks
+        run_queries(&area, QUERIES);
+        int indexed_hits = area.hits;
+        brick_grid_drop_index(&grid);
+        run_queries(&area, QUERIES);
+        int linear_hits = area.hits;
+        brick_grid_build_index(&grid);
+        if (indexed_hits != linear_hits) {
+            fprintf(stderr, "Mismatch at %d bricks: %d indexed hits vs %d linear hits\n",
+                    grid.count, indexed_hits, linear_hits);
+            return 1;
+        }
+        
+        snprintf(params, sizeof(params), "bricks=%d,index=grid", grid.count);
+        bench_measure("brick_grid_sweep", params, NULL, run_queries, &area, QUERIES);
+        
+        // A linear scan costs a pass over every brick, so sample fewer queries
+        int linear_queries = QUERIES * 100 / grid.count;
+        brick_grid_drop_index(&grid);
+        snprintf(params, sizeof(params), "bricks=%d,index=linear", grid.count);
+        bench_measure("brick_grid_sweep", params, NULL, run_queries, &area, linear_queries);
+    }
+    
+    // The 40x30 mega wall squeezed into the play field
+    brick_grid_create_wall(&grid, 40, 30);
+    SweepArea wall = area_of_index();
+    snprintf(params, sizeof(params), "bricks=%d,index=grid,wall=40x30", grid.count);
+    bench_measure("brick_grid_sweep", params, NULL, run_queries, &wall, QUERIES);
+    
+    brick_grid_cleanup(&grid);
+    return 0;
+}
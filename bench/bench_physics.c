@@ -0,0 +1,263 @@
+// Micro-benchmarks for stage generation, brick and ball physics and the
+// gameplay step. gameplay_move_ball and gameplay_update are the paths the game
+// runs; check_collision, all_destroyed and ball_update are kept as baselines
+// for the public API. Output is one JSON line per measurement, see bench.h.
+#include "bench.h"
+#include "brick.h"
+#include "ball.h"
+#include "gameplay.h"
+#include "autoplay.h"
+#include "game.h"
+#include <string.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define POSITIONS 4096
+#define DIRECTIONS 16
+
+static const int brick_counts[] = {100, 1000, 4000, 16000};
+
+typedef enum {
+    BALL_OVER_WALL,       // Anywhere over the bricks; hits knock them out as in play
+    BALL_BELOW_WALL,      // Open field between the wall and the paddle
+    BALL_OUTSIDE_GRID     // Off the brick index entirely, e.g. in the header
+} BallArea;
+
+static const char* const area_names[] = {"over_wall", "below_wall", "outside_grid"};
+
+typedef struct {
+    Gameplay gp;
+    int stage;            // Layout to measure; 0 for a wall of bricks
+    int bricks;
+    bool paddle_hit;
+    float x[POSITIONS];
+    float y[POSITIONS];
+    float vel_x[DIRECTIONS];
+    float vel_y[DIRECTIONS];
+} GameplayContext;
+
+// Deterministic positions so every run and every commit sees the same ones
+static Uint32 lcg_state;
+
+static float lcg_unit(void) {
+    lcg_state = lcg_state * 1664525u + 1013904223u;
+    return (lcg_state >> 8) / 16777216.0f;
+}
+
+static void place_positions(GameplayContext* ctx, BallArea area) {
+    BrickIndex* index = &ctx->gp.brick_grid.index;
+    float width = index->cols * index->cell_width;
+    float height = index->rows * index->cell_height;
+    lcg_state = 1234;
+    for (int i = 0; i < POSITIONS; i++) {
+        float u = lcg_unit();
+        float v = lcg_unit();
+        if (area == BALL_OVER_WALL) {
+            ctx->x[i] = index->origin_x + u * width;
+            ctx->y[i] = index->origin_y + v * height;
+        } else if (area == BALL_BELOW_WALL) {
+            ctx->x[i] = index->origin_x + u * width;
+            ctx->y[i] = index->origin_y + height + 20 + v * 300;
+        } else {
+            ctx->x[i] = index->origin_x - 100 - u * 100;
+            ctx->y[i] = index->origin_y - 100 - v * 50;
+        }
+    }
+    
+    // Launch speed in all directions, as after a few bounces
+    for (int i = 0; i < DIRECTIONS; i++) {
+        float angle = i * 2.0f * (float)M_PI / DIRECTIONS + 0.1f;
+        ctx->vel_x[i] = 250.0f * cosf(angle);
+        ctx->vel_y[i] = 250.0f * sinf(angle);
+    }
+}
+
+static void run_create_stage(void* context, int ops) {
+    GameplayContext* ctx = context;
+    for (int i = 0; i < ops; i++) {
+        brick_grid_create_stage(&ctx->gp.brick_grid, ctx->stage);
+    }
+    bench_sink = ctx->gp.brick_grid.count;
+}
+
+static void setup_layout(void* context) {
+    GameplayContext* ctx = context;
+    if (ctx->stage > 0) {
+        brick_grid_create_stage(&ctx->gp.brick_grid, ctx->stage);
+    } else {
+        bench_fill_wall(&ctx->gp.brick_grid, ctx->bricks);
+    }
+    ctx->gp.stage = ctx->stage > 0 ? ctx->stage : 1;
+    ctx->gp.stage_cleared = false;
+}
+
+static void run_move_ball(void* context, int ops) {
+    GameplayContext* ctx = context;
+    Ball* ball = &ctx->gp.ball;
+    for (int i = 0; i < ops; i++) {
+        int p = i % POSITIONS;
+        int d = i % DIRECTIONS;
+        ball->x = ctx->x[p];
+        ball->y = ctx->y[p];
+        ball->vel_x = ctx->vel_x[d];
+        ball->vel_y = ctx->vel_y[d];
+        gameplay_move_ball(&ctx->gp, SIMULATION_STEP);
+    }
+    bench_sink = ctx->gp.score;
+}
+
+static void run_check_collision(void* context, int ops) {
+    GameplayContext* ctx = context;
+    int hits = 0;
+    for (int i = 0; i < ops; i++) {
+        int p = i % POSITIONS;
+        hits += brick_grid_check_collision(&ctx->gp.brick_grid, ctx->x[p], ctx->y[p], 16, 16);
+    }
+    bench_sink = hits;
+}
+
+static void run_all_destroyed(void* context, int ops) {
+    GameplayContext* ctx = context;
+    int destroyed = 0;
+    for (int i = 0; i < ops; i++) {
+        destroyed += brick_grid_all_destroyed(&ctx->gp.brick_grid);
+        bench_sink = destroyed; // Keeps the call inside the loop
+    }
+}
+
+static void setup_ball(void* context) {
+    Ball* ball = context;
+    ball_init(ball, WINDOW_WIDTH / 2.0f, WINDOW_HEIGHT / 2.0f);
+    ball->vel_x = 230.0f;
+    ball->vel_y = -170.0f;
+}
+
+static void run_ball_update(void* context, int ops) {
+    Ball* ball = context;
+    int bounces = 0;
+    for (int i = 0; i < ops; i++) {
+        bounces += ball_update(ball, SIMULATION_STEP);
+        
+        // No floor in ball_check_walls; keep the ball in the box
+        if (ball->y > WINDOW_HEIGHT) ball->vel_y = -fabsf(ball->vel_y);
+    }
+    bench_sink = bounces;
+}
+
+static void run_gameplay_check_collisions(void* context, int ops) {
+    GameplayContext* ctx = context;
+    Ball* ball = &ctx->gp.ball;
+    Paddle* paddle = &ctx->gp.paddle;
+    int hits = 0;
+    for (int i = 0; i < ops; i++) {
+        // A bounce moves the ball, so put it back every time
+        if (ctx->paddle_hit) {
+            ball->x = paddle->x + (i % 48);
+            ball->y = paddle->y - ball->height / 2.0f;
+        } else {
+            ball->x = (float)(i % (WINDOW_WIDTH - 16));
+            ball->y = WINDOW_HEIGHT / 2.0f;
+        }
+        ball->vel_x = 100.0f;
+        ball->vel_y = 200.0f;
+        hits += gameplay_check_collisions(&ctx->gp);
+    }
+    bench_sink = hits;
+}
+
+static void setup_gameplay(void* context) {
+    GameplayContext* ctx = context;
+    gameplay_seed(&ctx->gp, 1);
+    gameplay_reset_game(&ctx->gp);
+}
+
+static void run_gameplay_update(void* context, int ops) {
+    GameplayContext* ctx = context;
+    int next_state = GAME_STATE_GAMEPLAY;
+    for (int i = 0; i < ops; i++) {
+        GameplayInput input;
+        autoplay_input(&ctx->gp, &input);
+        gameplay_update(&ctx->gp, &input, SIMULATION_STEP, &next_state);
+        if (next_state != GAME_STATE_GAMEPLAY) {
+            setup_gameplay(ctx);
+            next_state = GAME_STATE_GAMEPLAY;
+        }
+    }
+    bench_sink = ctx->gp.score;
+}
+
+static void measure_move_ball(GameplayContext* ctx, const char* layout) {
+    char params[64];
+    setup_layout(ctx);
+    for (int area = BALL_OVER_WALL; area <= BALL_BELOW_WALL; area++) {
+        place_positions(ctx, (BallArea)area);
+        snprintf(params, sizeof(params), "%s,ball=%s", layout, area_names[area]);
+        bench_measure("gameplay_move_ball", params, setup_layout, run_move_ball, ctx, 20000);
+    }
+}
+
+int main(void) {
+    static GameplayContext ctx;
+    char params[64];
+    
+    gameplay_init(&ctx.gp);
+    for (int stage = 1; stage <= GAMEPLAY_STAGE_COUNT; stage++) {
+        ctx.stage = stage;
+        snprintf(params, sizeof(params), "stage=%d", stage);
+        bench_measure("brick_grid_create_stage", params, NULL, run_create_stage, &ctx, 2000);
+    }
+    
+    // The ball's sweep through the brick field, on each stage and on walls
+    // far larger than any stage
+    for (int stage = 1; stage <= GAMEPLAY_STAGE_COUNT; stage++) {
+        ctx.stage = stage;
+        snprintf(params, sizeof(params), "stage=%d", stage);
+        measure_move_ball(&ctx, params);
+    }
+    ctx.stage = 0;
+    for (size_t i = 0; i < sizeof(brick_counts) / sizeof(brick_counts[0]); i++) {
+        ctx.bricks = brick_counts[i];
+        snprintf(params, sizeof(params), "bricks=%d", ctx.bricks);
+        measure_move_ball(&ctx, params);
+    }
+    
+    // Overlap tests at a point in time, knocking out what they touch
+    for (size_t i = 0; i < sizeof(brick_counts) / sizeof(brick_counts[0]); i++) {
+        ctx.bricks = brick_counts[i];
+        setup_layout(&ctx);
+        for (int area = BALL_OVER_WALL; area <= BALL_OUTSIDE_GRID; area++) {
+            place_positions(&ctx, (BallArea)area);
+            snprintf(params, sizeof(params), "bricks=%d,ball=%s", ctx.bricks, area_names[area]);
+            bench_measure("brick_grid_check_collision", params, setup_layout, run_check_collision,
+                          &ctx, 20000);
+        }
+    }
+    
+    // A standing wall answers on its first word, a cleared one scans them all
+    ctx.bricks = brick_counts[sizeof(brick_counts) / sizeof(brick_counts[0]) - 1];
+    setup_layout(&ctx);
+    snprintf(params, sizeof(params), "bricks=%d,wall=full", ctx.bricks);
+    bench_measure("brick_grid_all_destroyed", params, NULL, run_all_destroyed, &ctx, 1000000);
+    for (int b = 0; b < ctx.gp.brick_grid.count; b++) {
+        brick_grid_destroy_brick(&ctx.gp.brick_grid, b);
+    }
+    snprintf(params, sizeof(params), "bricks=%d,wall=empty", ctx.bricks);
+    bench_measure("brick_grid_all_destroyed", params, NULL, run_all_destroyed, &ctx, 10000);
+    
+    static Ball ball;
+    bench_measure("ball_update", "", setup_ball, run_ball_update, &ball, 1000000);
+    
+    ctx.paddle_hit = true;
+    bench_measure("gameplay_check_collisions", "ball=paddle", setup_gameplay,
+                  run_gameplay_check_collisions, &ctx, 1000000);
+    ctx.paddle_hit = false;
+    bench_measure("gameplay_check_collisions", "ball=open_field", setup_gameplay,
+                  run_gameplay_check_collisions, &ctx, 1000000);
+    
+    // One whole simulation step with the computer player at the controls
+    bench_measure("gameplay_update", "autoplay", setup_gameplay, run_gameplay_update, &ctx, 100000);
+    gameplay_cleanup(&ctx.gp);
+    return 0;
+}
@@ -0,0 +1,57 @@
+#ifndef ASSET_LOADER_H
+#define ASSET_LOADER_H
+
+#include <SDL.h>
+#include <stdbool.h>
+
+#define ASSET_LOADER_MAX_WORKERS 4
+#define ASSET_LOADER_MAX_JOBS 64 // In flight at once; slots are reused
+
+typedef struct AssetJob AssetJob;
+
+// decode runs on a worker thread and may only touch files and surfaces;
+// finish runs on the render thread and publishes the result to target
+typedef void (*AssetDecodeFunc)(AssetJob* job, void* user_data);
+typedef void (*AssetFinishFunc)(AssetJob* job, void* user_data);
+
+struct AssetJob {
+    const char* path;
+    void* target;
+    void* result;
+    AssetDecodeFunc decode;
+    AssetFinishFunc finish;
+    bool in_use;
+};
+
+typedef struct {
+    void* user_data;      // Handed to every decode and finish call
+    SDL_Thread* workers[ASSET_LOADER_MAX_WORKERS];
+    int worker_count;
+    SDL_mutex* lock;
+    SDL_cond* work_ready;
+    SDL_cond* job_decoded;
+    AssetJob jobs[ASSET_LOADER_MAX_JOBS];
+    int queue[ASSET_LOADER_MAX_JOBS];   // Jobs waiting for a worker, oldest first
+    int queue_head;
+    int queue_count;
+    int decoded[ASSET_LOADER_MAX_JOBS]; // Decoded jobs waiting for finish
+    int decoded_count;
+    int pending;          // Added but not yet finished; render thread only
+    int batch_jobs;       // Finished since the loader was last idle
+    Uint64 batch_start;
+    bool quit;
+} AssetLoader;
+
+// -1 when no worker could start; the loader still works, decoding one job
+// per poll on the calling thread
+int asset_loader_init(AssetLoader* loader, void* user_data);
+void asset_loader_cleanup(AssetLoader* loader);
+bool asset_loader_add(AssetLoader* loader, const char* path, void* target,
+                      AssetDecodeFunc decode, AssetFinishFunc finish);
+void asset_loader_poll(AssetLoader* loader);
+void asset_loader_wait(AssetLoader* loader);
+// Blocks until at least one job has finished; returns at once when idle
+void asset_loader_wait_one(AssetLoader* loader);
+bool asset_loader_busy(const AssetLoader* loader);
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef ASSET_PACK_H
+#define ASSET_PACK_H
+
+#include <SDL.h>
+#include <SDL_mixer.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Mixer output format; sound effects in the pack are stored already converted to it
+#define AUDIO_FREQUENCY 44100
+#define AUDIO_FORMAT MIX_DEFAULT_FORMAT
+#define AUDIO_CHANNELS 2
+#define AUDIO_CHUNK_SIZE 2048             // ~46 ms at 44.1 kHz
+#define AUDIO_CHUNK_SIZE_LOW_LATENCY 512  // ~12 ms, BRICKOUT_LOW_LATENCY_AUDIO=1
+
+// Built by `make pack`; the game falls back to the source files without it
+#define ASSET_PACK_FILE "assets.pack"
+#define ASSET_PACK_MAGIC 0x4B504B42 // "BKPK"
+#define ASSET_PACK_VERSION 1
+#define ASSET_PACK_PATH_MAX 96
+#define ASSET_PACK_ALIGN 64
+
+typedef enum {
+    ASSET_PACK_IMAGE = 1, // RGBA32 pixels, ready for SDL_UpdateTexture
+    ASSET_PACK_PCM = 2    // Samples in the mixer output format
+} AssetPackKind;
+
+typedef struct {
+    Uint32 magic;
+    Uint32 version;
+    Uint32 entry_count;
+    Uint32 reserved;
+} AssetPackHeader;
+
+typedef struct {
+    char path[ASSET_PACK_PATH_MAX]; // Source path the game asks for
+    Uint32 kind;
+    Uint32 width;       // Images
+    Uint32 height;
+    Uint32 pitch;
+    Uint32 frequency;   // PCM
+    Uint16 format;
+    Uint16 channels;
+    Uint64 offset;      // From the start of the file, ASSET_PACK_ALIGN aligned
+    Uint64 size;
+} AssetPackEntry;
+
+typedef struct {
+    void* data;           // Whole file, mapped read-only
+    size_t size;
+    const AssetPackHeader* header;
+    const AssetPackEntry* entries;
+    bool pcm_usable;      // PCM matches the format the mixer actually opened
+} AssetPack;
+
+int asset_pack_open(AssetPack* pack, const char* path);
+void asset_pack_close(AssetPack* pack);
+const AssetPackEntry* asset_pack_find(const AssetPack* pack, const char* path, AssetPackKind kind);
+const void* asset_pack_data(const AssetPack* pack, const AssetPackEntry* entry);
+
+// Wrap pack data without copying; the pack must outlive the results
+SDL_Surface* asset_pack_surface(const AssetPack* pack, const AssetPackEntry* entry);
+Mix_Chunk* asset_pack_chunk(const AssetPack* pack, const AssetPackEntry* entry);
+
+#endif
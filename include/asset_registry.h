@@ -0,0 +1,105 @@
+#ifndef ASSET_REGISTRY_H
+#define ASSET_REGISTRY_H
+
+#include <SDL.h>
+#include <SDL_mixer.h>
+#include <stdbool.h>
+#include "asset_loader.h"
+#include "asset_pack.h"
+#include "sfx_cache.h"
+
+// Every asset the game can load, one per line: <type> <name> <path>
+#define ASSET_MANIFEST_FILE "docs/assets/manifest.txt"
+#define ASSET_MAX 64
+#define ASSET_NAME_MAX 32
+#define ASSET_HASH_SIZE 128 // Power of two, at least twice ASSET_MAX
+
+// Sprites are packed into one page, loaded and dropped together
+#define SPRITE_PAGE_WIDTH 512
+#define SPRITE_PAGE_PADDING 1
+
+typedef struct {
+    SDL_Texture* texture;
+    SDL_Rect src;         // Region of the texture holding the image, empty means all of it
+    int width;
+    int height;
+} Texture;
+
+// Index into the registry table, stable once the manifest is read
+typedef int AssetId;
+#define ASSET_ID_NONE (-1)
+
+typedef enum {
+    ASSET_TYPE_IMAGE,     // Texture of its own
+    ASSET_TYPE_SPRITE,    // Region of the shared sprite page
+    ASSET_TYPE_MUSIC,
+    ASSET_TYPE_SOUND,
+    ASSET_TYPE_COUNT
+} AssetType;
+
+typedef enum {
+    ASSET_UNLOADED,
+    ASSET_LOADING,
+    ASSET_LOADED,
+    ASSET_FAILED
+} AssetState;
+
+typedef struct {
+    char name[ASSET_NAME_MAX];
+    char path[ASSET_PACK_PATH_MAX];
+    AssetType type;
+    AssetState state;
+    int refcount;
+    int priority;         // Sounds: voice priority, see play_sfx
+    size_t bytes;         // Estimated memory held while loaded
+    Texture texture;      // Images and sprites
+    Mix_Music* music;
+    Mix_Chunk* chunk;
+} Asset;
+
+typedef struct {
+    SDL_Renderer* renderer;
+    Asset assets[ASSET_MAX];
+    int count;
+    Sint16 hash[ASSET_HASH_SIZE]; // Interned names, ASSET_ID_NONE when empty
+    AssetLoader loader;
+    AssetPack pack;       // Pre-decoded assets, used in place of the source files when present
+    SfxCache sfx_cache;   // Sound effects not in the pack, converted on an earlier run
+    SDL_Texture* sprite_page;
+    AssetState page_state;
+    int sprite_refs;      // Sum of sprite refcounts; the page goes at zero
+    AssetId pending_music; // Requested to play before it finished loading
+    
+    // Resident memory by asset type and the most it has reached
+    size_t resident_bytes[ASSET_TYPE_COUNT];
+    size_t peak_bytes[ASSET_TYPE_COUNT];
+    size_t resident_total;
+    size_t peak_total;
+} AssetRegistry;
+
+int asset_registry_init(AssetRegistry* reg, SDL_Renderer* renderer, const char* manifest_path);
+void asset_registry_cleanup(AssetRegistry* reg);
+void asset_registry_update(AssetRegistry* reg);
+void asset_registry_wait(AssetRegistry* reg);
+// Finishes loads only until the given assets have arrived or failed
+void asset_registry_wait_for(AssetRegistry* reg, const AssetId* ids, int count);
+bool asset_registry_busy(const AssetRegistry* reg);
+float asset_registry_progress(const AssetRegistry* reg);
+
+// Lookups don't load anything; acquire takes a reference and starts the
+// load on first use, release drops it and unloads at zero
+AssetId asset_find(const AssetRegistry* reg, const char* name);
+AssetId asset_acquire(AssetRegistry* reg, const char* name);
+void asset_release(AssetRegistry* reg, AssetId id);
+bool asset_ready(const AssetRegistry* reg, AssetId id);
+
+// Never NULL; an asset that isn't loaded yet yields an empty Texture
+const Texture* asset_texture(const AssetRegistry* reg, AssetId id);
+Mix_Music* asset_music(const AssetRegistry* reg, AssetId id);
+Mix_Chunk* asset_sound(const AssetRegistry* reg, AssetId id);
+
+// Music still loading starts as soon as it arrives
+void asset_play_music(AssetRegistry* reg, AssetId id);
+void asset_play_sound(AssetRegistry* reg, AssetId id);
+
+#endif
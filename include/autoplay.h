@@ -0,0 +1,11 @@
+#ifndef AUTOPLAY_H
+#define AUTOPLAY_H
+
+#include "gameplay.h"
+
+// Computer player: fills in the arrow keys the way a person would hold
+// them, from where the ball is heading and which bricks are left. Reads
+// the simulation only, so the same state always gets the same input.
+void autoplay_input(Gameplay* gp, GameplayInput* input);
+
+#endif
@@ -6,16 +6,22 @@
 
 typedef struct {
     float x, y;           // Position
+    float prev_x, prev_y; // Position at the previous simulation step
     float vel_x, vel_y;   // Velocity
     int width, height;    // Size
-    SDL_Texture* texture; // Ball texture
+    const Texture* sprite; // Registry-owned and set by the view, NULL when headless
 } Ball;
 
-void ball_init(Ball* ball, float x, float y, SDL_Texture* texture);
-void ball_update(Ball* ball, float delta_time, TextureManager* tm);
-void ball_render(Ball* ball, SDL_Renderer* renderer);
-void ball_bounce_x(Ball* ball, TextureManager* tm);
-void ball_bounce_y(Ball* ball, TextureManager* tm);
-void ball_reset(Ball* ball, float x, float y);
+void ball_init(Ball* ball, float x, float y);
+// Both return true when the ball bounced off a wall. Gameplay moves the ball
+// with gameplay_move_ball and only checks walls; ball_update is the unswept
+// step, kept for callers without bricks and as a benchmark baseline.
+bool ball_update(Ball* ball, float delta_time);
+bool ball_check_walls(Ball* ball);
+void ball_render(Ball* ball, SpriteBatch* batch, float alpha);
+void ball_bounce_x(Ball* ball);
+void ball_bounce_y(Ball* ball);
+// Launches upward at angle_degrees from vertical, negative to the left
+void ball_reset(Ball* ball, float x, float y, float angle_degrees);
 
 #endif
\ No newline at end of file
@@ -3,6 +3,8 @@
 
 #include <SDL.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include "texture_manager.h"
 
 typedef enum {
     BRICK_RED,
@@ -13,28 +15,82 @@ typedef enum {
     BRICK_TYPES_COUNT
 } BrickType;
 
+// Uniform grid of cells over the brick field, rebuilt when a stage is created
 typedef struct {
-    float x, y;           // Position
-    int width, height;    // Size
-    BrickType type;       // Brick color/type
-    bool destroyed;       // Is brick destroyed?
-    SDL_Texture* texture; // Brick texture
-} Brick;
+    float origin_x, origin_y;
+    float cell_width, cell_height;
+    int cols, rows;
+    int* cell_start;      // Offsets into cell_bricks, cols * rows + 1 entries
+    int* cell_bricks;     // Brick indices grouped by cell
+    int cell_capacity;
+    int entry_capacity;
+} BrickIndex;
 
-#define MAX_BRICKS 100
+typedef enum {
+    BRICK_EVENT_DESTROYED,     // A brick was knocked out
+    BRICK_EVENT_STAGE_CLEARED  // The last standing brick was knocked out
+} BrickEvent;
+
+#define BRICK_LAYER_MAX_ERASES 32
+
+typedef void (*BrickEventCallback)(BrickEvent event, int index, void* user_data);
 
+// Bricks are stored as parallel arrays carved from one block that grows on
+// demand and is kept across stages. Bit i of live is set while brick i stands.
 typedef struct {
-    Brick bricks[MAX_BRICKS];
+    float* x;
+    float* y;
+    float* width;
+    float* height;
+    Uint8* type;
+    Uint64* live;
     int count;
-    SDL_Texture* textures[BRICK_TYPES_COUNT];
+    int capacity;
+    int live_count;       // Standing bricks, kept in step with live
+    void* block;
+    const Texture* textures[BRICK_TYPES_COUNT]; // Registry-owned, may be NULL
+    BrickIndex index;
+    BrickEventCallback on_event;
+    void* event_user_data;
+    
+    // Standing bricks pre-rendered into a render target; redrawn in full
+    // when a layout is created and patched when single bricks fall
+    SDL_Texture* layer;
+    bool layer_dirty;
+    bool layer_unsupported;
+    SDL_Rect layer_erases[BRICK_LAYER_MAX_ERASES];
+    int layer_erase_count;
 } BrickGrid;
 
-void brick_init(Brick* brick, float x, float y, BrickType type, SDL_Texture* texture);
-void brick_render(Brick* brick, SDL_Renderer* renderer);
-void brick_grid_init(BrickGrid* grid, SDL_Texture* textures[BRICK_TYPES_COUNT]);
+// First contact of a moving box against the brick field
+typedef struct {
+    int index;               // Brick that was hit
+    float time;              // Fraction of the move completed at contact (0..1)
+    float normal_x, normal_y; // Contact normal pointing out of the brick, 0 on unmoving axes
+} BrickHit;
+
+// textures may be NULL for a grid that is only simulated
+void brick_grid_init(BrickGrid* grid, const Texture* const textures[BRICK_TYPES_COUNT]);
+void brick_grid_cleanup(BrickGrid* grid);
+void brick_grid_set_event_callback(BrickGrid* grid, BrickEventCallback callback, void* user_data);
 void brick_grid_create_stage(BrickGrid* grid, int stage);
-void brick_grid_render(BrickGrid* grid, SDL_Renderer* renderer);
+void brick_grid_create_wall(BrickGrid* grid, int cols, int rows);
+bool brick_grid_reserve(BrickGrid* grid, int capacity);
+// Empties the grid, keeping its storage; build the index once bricks are added
+void brick_grid_clear(BrickGrid* grid);
+int brick_grid_add(BrickGrid* grid, float x, float y, int width, int height, BrickType type);
+bool brick_grid_is_live(BrickGrid* grid, int index);
+void brick_grid_build_index(BrickGrid* grid);
+// Without an index every query walks all standing bricks
+void brick_grid_drop_index(BrickGrid* grid);
+void brick_grid_render(BrickGrid* grid, SpriteBatch* batch);
+void brick_grid_invalidate_layer(BrickGrid* grid, bool textures_lost);
+// Knocks out a brick the ball overlaps, via a zero-length brick_grid_sweep
 bool brick_grid_check_collision(BrickGrid* grid, float ball_x, float ball_y, float ball_w, float ball_h);
 bool brick_grid_all_destroyed(BrickGrid* grid);
+// A zero-length sweep reports a brick already overlapping at time 0
+bool brick_grid_sweep(BrickGrid* grid, float ball_x, float ball_y, float ball_w, float ball_h,
+                      float move_x, float move_y, BrickHit* hit);
+void brick_grid_destroy_brick(BrickGrid* grid, int index);
 
 #endif
\ No newline at end of file
@@ -14,9 +14,17 @@ typedef struct {
     CompleteOption current_option;
     TextureManager* texture_manager;
     int final_score;
+    
+    // Held while the screen is shown, released by complete_screen_cleanup
+    AssetId background;
+    AssetId kion_happi;
+    AssetId arrow;
+    AssetId menu_select;
+    AssetId bgm;
 } CompleteScreen;
 
 void complete_screen_init(CompleteScreen* cs, TextureManager* tm, int score);
+void complete_screen_cleanup(CompleteScreen* cs);
 void complete_screen_handle_input(CompleteScreen* cs, SDL_Event* e, int* next_state);
 void complete_screen_update(CompleteScreen* cs, float delta_time);
 void complete_screen_render(CompleteScreen* cs, SDL_Renderer* renderer);
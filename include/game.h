@@ -11,11 +11,22 @@
 #include "gameplay.h"
 #include "gameover_screen.h"
 #include "complete_screen.h"
+#include "replay.h"
+#include "autoplay.h"
+#include "profiler.h"
+#include "trace.h"
 
 #define WINDOW_WIDTH 640
 #define WINDOW_HEIGHT 480
 #define WINDOW_TITLE "Brickout"
 
+// Simulation runs at a fixed rate independent of the render frame rate
+#define SIMULATION_HZ 240
+#define SIMULATION_STEP (1.0f / SIMULATION_HZ)
+#define TARGET_FPS 60
+#define MAX_FRAME_TIME 0.25 // Clamp long frames so the simulation can catch up
+#define AUTOPLAY_END_SCREEN_TICKS (SIMULATION_HZ * 3) // How long autoplay shows the result
+
 typedef enum {
     GAME_STATE_TITLE,
     GAME_STATE_GAMEPLAY,
@@ -24,21 +35,35 @@ typedef enum {
     GAME_STATE_QUIT
 } GameState;
 
+typedef struct {
+    const char* record_path; // Save each run's replay here, overwriting the last
+    const char* replay_path; // Play this replay back instead of reading the keyboard
+    bool autoplay;           // Computer plays, starting a new run after each one ends
+} GameOptions;
+
 typedef struct {
     SDL_Window* window;
     SDL_Renderer* renderer;
     GameState current_state;
     bool running;
-    int last_time;
-    float delta_time;
+    bool vsync;
+    Uint64 last_counter;
+    Uint64 accumulator;   // Unsimulated time in performance counter ticks
+    float delta_time;     // Always SIMULATION_STEP
+    float render_alpha;   // Fraction of a step between the last two states
     TextureManager texture_manager;
     TitleScreen title_screen;
     Gameplay gameplay;
     GameOverScreen gameover_screen;
     CompleteScreen complete_screen;
+    GameOptions options;
+    Replay replay;
+    Profiler profiler;
+    int replay_tick;      // Next step to feed from the replay
+    int autoplay_wait;    // Steps the current end screen has been up
 } Game;
 
-int game_init(Game* game);
+int game_init(Game* game, const GameOptions* options);
 void game_run(Game* game);
 void game_cleanup(Game* game);
 void game_handle_events(Game* game);
@@ -15,9 +15,17 @@ typedef struct {
     TextureManager* texture_manager;
     int final_score;
     int final_stage;
+    
+    // Held while the screen is shown, released by gameover_screen_cleanup
+    AssetId background;
+    AssetId kion_ded;
+    AssetId arrow;
+    AssetId menu_select;
+    AssetId bgm;
 } GameOverScreen;
 
 void gameover_screen_init(GameOverScreen* gos, TextureManager* tm, int score, int stage);
+void gameover_screen_cleanup(GameOverScreen* gos);
 void gameover_screen_handle_input(GameOverScreen* gos, SDL_Event* e, int* next_state);
 void gameover_screen_update(GameOverScreen* gos, float delta_time);
 void gameover_screen_render(GameOverScreen* gos, SDL_Renderer* renderer);
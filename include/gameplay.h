@@ -7,23 +7,82 @@
 #include "brick.h"
 #include "texture_manager.h"
 
+#define GAMEPLAY_STAGE_COUNT 5
+
+// One-shot commands from key presses, applied at the start of the next step
+#define GAMEPLAY_COMMAND_NEXT_STAGE 0x01
+#define GAMEPLAY_COMMAND_TOGGLE_PAUSE 0x02
+
+// Controls sampled once per simulation step, from the keyboard, a script or a replay
 typedef struct {
+    bool left;
+    bool right;
+    Uint8 commands;       // GAMEPLAY_COMMAND_* bits
+} GameplayInput;
+
+// Things the simulation reports for sound and music to react to
+typedef enum {
+    GAMEPLAY_EVENT_BALL_PADDLE,
+    GAMEPLAY_EVENT_BALL_WALL,
+    GAMEPLAY_EVENT_BALL_BRICK,
+    GAMEPLAY_EVENT_LIFE_LOST,
+    GAMEPLAY_EVENT_STAGE_STARTED
+} GameplayEvent;
+
+typedef struct Gameplay Gameplay;
+
+typedef void (*GameplayEventCallback)(Gameplay* gp, GameplayEvent event, void* user_data);
+
+struct Gameplay {
     Ball ball;
     Paddle paddle;
     BrickGrid brick_grid;
-    TextureManager* texture_manager;
     int lives;
     int score;
     int stage;
     bool paused;
-} Gameplay;
+    bool stage_cleared;   // Set by the brick grid when the last brick falls
+    Uint8 pending_commands; // Key presses waiting for the next step
+    Uint32 rng_state;     // Launch angles come from here, never from rand()
+    GameplayEventCallback on_event;
+    void* event_user_data;
+    
+    // Presentation, set up by gameplay_view_init and unused when headless
+    TextureManager* texture_manager;
+    AssetId background;
+    AssetId ball_sprite;
+    AssetId paddle_sprite;
+    AssetId brick_sprites[BRICK_TYPES_COUNT];
+    AssetId sfx_ball_paddle;
+    AssetId sfx_ball_brick;
+    AssetId sfx_ball_wall;
+    AssetId sfx_lose_life;
+    
+    // Only the track playing and the one after it are held at a time
+    AssetId stage_bgm;
+    AssetId next_bgm;
+};
 
-void gameplay_init(Gameplay* gp, TextureManager* tm);
+// Simulation (gameplay.c); needs no window, renderer or audio device
+void gameplay_init(Gameplay* gp);
+void gameplay_cleanup(Gameplay* gp);
+void gameplay_set_event_callback(Gameplay* gp, GameplayEventCallback callback, void* user_data);
+// The same seed and inputs always play out the same way
+void gameplay_seed(Gameplay* gp, Uint32 seed);
+Uint32 gameplay_state_hash(const Gameplay* gp);
 void gameplay_handle_input(Gameplay* gp, SDL_Event* e, int* next_state);
-void gameplay_update(Gameplay* gp, float delta_time, int* next_state);
-void gameplay_render(Gameplay* gp, SDL_Renderer* renderer);
+void gameplay_update(Gameplay* gp, const GameplayInput* input, float delta_time, int* next_state);
 void gameplay_reset_ball(Gameplay* gp);
 void gameplay_reset_game(Gameplay* gp);
 bool gameplay_check_collisions(Gameplay* gp);
+void gameplay_move_ball(Gameplay* gp, float delta_time);
+
+// Presentation (gameplay_view.c): sprites, sound and music for the simulation
+void gameplay_view_init(Gameplay* gp, TextureManager* tm);
+void gameplay_view_cleanup(Gameplay* gp);
+// Blocks until the sprites are in; background, sounds and music keep loading
+void gameplay_view_wait_sprites(Gameplay* gp);
+void gameplay_leave(Gameplay* gp);
+void gameplay_render(Gameplay* gp, SDL_Renderer* renderer, float alpha);
 
-#endif
\ No newline at end of file
+#endif
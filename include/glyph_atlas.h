@@ -0,0 +1,33 @@
+#ifndef GLYPH_ATLAS_H
+#define GLYPH_ATLAS_H
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include "sprite_batch.h"
+
+// Printable ASCII is rasterized once into a single texture page
+#define GLYPH_FIRST 32
+#define GLYPH_LAST 126
+#define GLYPH_COUNT (GLYPH_LAST - GLYPH_FIRST + 1)
+#define GLYPH_PAGE_WIDTH 512
+
+typedef struct {
+    SDL_Rect src;         // Glyph image within the page
+    int advance;          // Horizontal pen advance
+} Glyph;
+
+typedef struct {
+    SDL_Texture* texture; // Page holding every glyph, rendered in white
+    TTF_Font* font;
+    Glyph glyphs[GLYPH_COUNT];
+    int page_width;
+    int page_height;
+    int line_height;
+} GlyphAtlas;
+
+int glyph_atlas_init(GlyphAtlas* atlas, SDL_Renderer* renderer, TTF_Font* font);
+void glyph_atlas_cleanup(GlyphAtlas* atlas);
+void glyph_atlas_measure(GlyphAtlas* atlas, const char* text, int* width, int* height);
+void glyph_atlas_draw(GlyphAtlas* atlas, SpriteBatch* batch, const char* text, int x, int y, SDL_Color color);
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <SDL.h>
+#include <stdbool.h>
+
+// Leveled logging. Messages are formatted on the calling thread and queued;
+// a background thread writes them to stdout, so no frame waits on the
+// terminal. When the queue is full, debug and info messages are dropped
+// and counted, while warnings and errors are written directly.
+//
+// BRICKOUT_LOG picks the runtime levels: a default level and per-module
+// overrides, e.g. BRICKOUT_LOG=warn,assets=debug. The default is info.
+// Levels below LOG_COMPILE_LEVEL (`make LOG_LEVEL=WARN`) are compiled out.
+typedef enum {
+    LOG_LEVEL_DEBUG,
+    LOG_LEVEL_INFO,
+    LOG_LEVEL_WARN,
+    LOG_LEVEL_ERROR,
+    LOG_LEVEL_NONE
+} LogLevel;
+
+typedef enum {
+    LOG_GAME,             // Startup, shutdown and screen changes
+    LOG_GAMEPLAY,
+    LOG_ASSETS,           // Manifest, registry, loader, pack and caches
+    LOG_AUDIO,
+    LOG_RENDER,
+    LOG_REPLAY,
+    LOG_TRACE,
+    LOG_MODULE_COUNT
+} LogModule;
+
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL LOG_LEVEL_DEBUG
+#endif
+
+#define LOG_QUEUE_SIZE 1024   // Messages waiting for the writer thread
+#define LOG_MESSAGE_MAX 256   // Longer messages are cut short
+
+// Before log_init and after log_shutdown messages are written directly
+void log_init(void);
+void log_shutdown(void);
+void log_set_level(LogModule module, LogLevel level);
+bool log_enabled(LogLevel level, LogModule module);
+#if defined(__GNUC__)
+__attribute__((format(printf, 3, 4)))
+#endif
+void log_write(LogLevel level, LogModule module, const char* format, ...);
+
+#define LOG_AT(level, module, ...) \
+    do { \
+        if ((level) >= LOG_COMPILE_LEVEL && log_enabled((level), (module))) { \
+            log_write((level), (module), __VA_ARGS__); \
+        } \
+    } while (0)
+#define LOG_DEBUG(module, ...) LOG_AT(LOG_LEVEL_DEBUG, module, __VA_ARGS__)
+#define LOG_INFO(module, ...) LOG_AT(LOG_LEVEL_INFO, module, __VA_ARGS__)
+#define LOG_WARN(module, ...) LOG_AT(LOG_LEVEL_WARN, module, __VA_ARGS__)
+#define LOG_ERROR(module, ...) LOG_AT(LOG_LEVEL_ERROR, module, __VA_ARGS__)
+
+#endif
@@ -2,16 +2,19 @@
 #define PADDLE_H
 
 #include <SDL.h>
+#include "texture_manager.h"
 
 typedef struct {
     float x, y;           // Position
+    float prev_x, prev_y; // Position at the previous simulation step
     int width, height;    // Size
     float speed;          // Movement speed
-    SDL_Texture* texture; // Paddle texture
+    const Texture* sprite; // Registry-owned and set by the view, NULL when headless
 } Paddle;
 
-void paddle_init(Paddle* paddle, float x, float y, SDL_Texture* texture);
-void paddle_update(Paddle* paddle, const Uint8* keyboard_state, float delta_time);
-void paddle_render(Paddle* paddle, SDL_Renderer* renderer);
+void paddle_init(Paddle* paddle, float x, float y);
+// direction is -1 for left, 1 for right, 0 to stay put
+void paddle_update(Paddle* paddle, int direction, float delta_time);
+void paddle_render(Paddle* paddle, SpriteBatch* batch, float alpha);
 
 #endif
\ No newline at end of file
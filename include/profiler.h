@@ -0,0 +1,65 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <stdbool.h>
+#include "glyph_atlas.h"
+#include "texture_manager.h"
+
+// Frame timing overlay, toggled with F3 (BRICKOUT_PROFILER=1 starts with it up)
+#define PROFILER_HISTORY 240        // Frames in the rolling window, 4 s at 60 fps
+#define PROFILER_STATS_INTERVAL 15  // Frames between refreshes of the figures
+#define PROFILER_SPIKE_MS 33.3f     // Two frames at 60 fps
+#define PROFILER_FONT "docs/assets/Font/Kenney Future Narrow.ttf"
+#define PROFILER_FONT_SIZE 14
+
+typedef enum {
+    PROFILE_EVENTS,       // Event polling and asset loader housekeeping
+    PROFILE_UPDATE,       // Every simulation step run this frame
+    PROFILE_RENDER,       // Drawing, up to but not including the present
+    PROFILE_PRESENT,      // SDL_RenderPresent, where vsync waits
+    PROFILE_PHASE_COUNT
+} ProfilePhase;
+
+typedef struct {
+    bool visible;
+    Uint64 frequency;
+    Uint64 frame_start;
+    Uint64 phase_start[PROFILE_PHASE_COUNT];
+    float phase_current[PROFILE_PHASE_COUNT]; // Frame in progress, in ms
+    
+    // Ring of the last PROFILER_HISTORY completed frames, in ms
+    float frame_ms[PROFILER_HISTORY];
+    float phase_ms[PROFILE_PHASE_COUNT][PROFILER_HISTORY];
+    int head;             // Slot the next frame goes in
+    int count;
+    
+    // Figures on display, refreshed every PROFILER_STATS_INTERVAL frames
+    float p50, p99, max;
+    float phase_avg[PROFILE_PHASE_COUNT];
+    float phase_max[PROFILE_PHASE_COUNT];
+    int frames_since_stats;
+    
+    Uint32 frames;        // Since startup
+    Uint32 spikes;        // Frames longer than PROFILER_SPIKE_MS since startup
+    
+    // Opened the first time the overlay is shown
+    TTF_Font* font;
+    GlyphAtlas glyphs;
+    bool font_failed;
+} Profiler;
+
+void profiler_init(Profiler* profiler);
+void profiler_cleanup(Profiler* profiler);
+void profiler_toggle(Profiler* profiler);
+
+// Frames are measured from one profiler_begin_frame to the next
+void profiler_begin_frame(Profiler* profiler);
+void profiler_begin(Profiler* profiler, ProfilePhase phase);
+void profiler_end(Profiler* profiler, ProfilePhase phase);
+
+// Queues the overlay on tm->sprites when visible
+void profiler_render(Profiler* profiler, TextureManager* tm);
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <SDL.h>
+#include <stdbool.h>
+#include "gameplay.h"
+
+// A recorded run: the seed it started from and the input of every
+// simulation step after that. Played back through the same fixed step it
+// reproduces the run exactly, which the end state hash confirms.
+#define REPLAY_MAGIC 0x4c505242 // "BRPL"
+#define REPLAY_VERSION 1
+
+typedef struct {
+    Uint32 magic;
+    Uint16 version;
+    Uint16 simulation_hz;
+    Uint32 seed;
+    Uint32 tick_count;
+    Uint32 end_hash;      // gameplay_state_hash after the last tick
+    Uint32 payload_size;  // Run-length encoded inputs following the header
+} ReplayHeader;
+
+typedef struct {
+    Uint32 seed;
+    Uint32 end_hash;
+    Uint8* ticks;         // One packed GameplayInput per step
+    int tick_count;
+    int capacity;
+} Replay;
+
+void replay_begin(Replay* replay, Uint32 seed);
+void replay_record(Replay* replay, const GameplayInput* input);
+void replay_free(Replay* replay);
+
+// Input for step tick; false once the recording has run out
+bool replay_input(const Replay* replay, int tick, GameplayInput* input);
+
+bool replay_save(Replay* replay, const char* path, Uint32 end_hash);
+bool replay_load(Replay* replay, const char* path);
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef SFX_CACHE_H
+#define SFX_CACHE_H
+
+#include <SDL.h>
+#include <SDL_mixer.h>
+#include <stdbool.h>
+
+// Converted sound effects written to the user's pref dir after the first
+// decode, keyed by source file hash and mixer spec
+#define SFX_CACHE_ORG "pibit"
+#define SFX_CACHE_APP "brickout"
+#define SFX_CACHE_MAGIC 0x58465342 // "BSFX"
+#define SFX_CACHE_VERSION 1
+#define SFX_CACHE_PATH_MAX 512
+
+typedef struct {
+    Uint32 magic;
+    Uint32 version;
+    Uint64 source_hash;   // FNV-1a of the encoded source file
+    Uint32 frequency;
+    Uint16 format;
+    Uint16 channels;
+    Uint32 size;          // PCM bytes following the header
+    Uint32 reserved;
+} SfxCacheHeader;
+
+typedef struct {
+    bool enabled;
+    char dir[SFX_CACHE_PATH_MAX];
+    int frequency;
+    Uint16 format;
+    int channels;
+    
+    // Updated from the loader's worker threads
+    SDL_atomic_t hits;
+    SDL_atomic_t misses;
+    SDL_atomic_t hit_us;  // Time spent loading, in microseconds
+    SDL_atomic_t miss_us;
+} SfxCache;
+
+// Needs the mixer open; the cache stays disabled when it isn't
+void sfx_cache_init(SfxCache* cache);
+void sfx_cache_report(const SfxCache* cache);
+
+// Thread-safe. Falls back to decoding the source when the cache is disabled
+Mix_Chunk* sfx_cache_load(SfxCache* cache, const char* path);
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef SPRITE_BATCH_H
+#define SPRITE_BATCH_H
+
+#include <SDL.h>
+
+#define SPRITE_BATCH_CAPACITY 1024 // Sprites per submission
+
+typedef struct {
+    int draw_calls;       // SDL_RenderGeometry submissions
+    int vertices;
+    int sprites;
+} SpriteBatchStats;
+
+// Queues textured quads and submits runs that share a texture as one
+// SDL_RenderGeometry call. Anything drawn directly on the renderer must
+// flush the batch first to keep draw order.
+typedef struct {
+    SDL_Renderer* renderer;
+    SDL_Texture* texture; // Texture of the queued sprites
+    float inv_texture_width;
+    float inv_texture_height;
+    SDL_Vertex* vertices;
+    int* indices;
+    int sprite_count;
+    SpriteBatchStats frame;      // Frame in progress
+    SpriteBatchStats last_frame; // Most recently completed frame
+    SpriteBatchStats total;
+    int frames;
+} SpriteBatch;
+
+int sprite_batch_init(SpriteBatch* batch, SDL_Renderer* renderer);
+void sprite_batch_cleanup(SpriteBatch* batch);
+void sprite_batch_begin_frame(SpriteBatch* batch);
+void sprite_batch_draw(SpriteBatch* batch, SDL_Texture* texture, const SDL_Rect* src,
+                       float x, float y, float width, float height, SDL_Color color);
+void sprite_batch_flush(SpriteBatch* batch);
+
+#endif
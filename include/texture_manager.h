@@ -5,59 +5,82 @@
 #include <SDL_image.h>
 #include <SDL_ttf.h>
 #include <SDL_mixer.h>
+#include "glyph_atlas.h"
+#include "sprite_batch.h"
+#include "asset_registry.h"
 
+#define TEXT_CACHE_SIZE 32
+#define TEXT_CACHE_MAX_LEN 128
+
+// Music is decoded as it plays, read from disk this many bytes at a time
+#define MUSIC_STREAM_CHUNK (32 * 1024)
+
+// Sound effects share a fixed set of mixer channels; when all are busy a new
+// sound takes over the lowest-priority one, oldest first among equals
+#define SFX_VOICES 16
+#define SFX_PRIORITY_DEFAULT 1
+
+// Rendered text kept around between frames, keyed by font, string and color
 typedef struct {
+    TTF_Font* font;
+    SDL_Color color;
+    char text[TEXT_CACHE_MAX_LEN];
     SDL_Texture* texture;
     int width;
     int height;
-} Texture;
+    Uint32 last_used;
+} TextCacheEntry;
+
+typedef struct {
+    TextCacheEntry entries[TEXT_CACHE_SIZE];
+    Uint32 use_counter;
+    Uint32 hits;
+    Uint32 misses;
+} TextCache;
 
 typedef struct {
     SDL_Renderer* renderer;
-    Texture background;
-    Texture logo;
-    Texture dashie;
-    Texture kion_ded;
-    Texture kion_happi;
-    Texture arrow;
-    Texture ball;
-    Texture paddle;
-    Texture brick_red;
-    Texture brick_yellow;
-    Texture brick_green;
-    Texture brick_blue;
-    Texture brick_purple;
     TTF_Font* font_regular;
     TTF_Font* font_title;
+    GlyphAtlas glyphs_regular;
+    GlyphAtlas glyphs_title;
     
-    // BGM tracks
-    Mix_Music* bgm_title;
-    Mix_Music* bgm_stage1;
-    Mix_Music* bgm_stage2;
-    Mix_Music* bgm_stage3;
-    Mix_Music* bgm_stage4;
-    Mix_Music* bgm_stage5;
-    Mix_Music* bgm_gameover;
-    Mix_Music* bgm_complete;
+    // Text textures reused across frames
+    TextCache text_cache;
     
-    // SFX
-    Mix_Chunk* sfx_ball_paddle;
-    Mix_Chunk* sfx_ball_wall;
-    Mix_Chunk* sfx_ball_brick;
-    Mix_Chunk* sfx_brick_break;
-    Mix_Chunk* sfx_lose_life;
-    Mix_Chunk* sfx_menu_select;
+    // Shared by every screen; text and sprites are queued here
+    SpriteBatch sprites;
+    
+    // Images and audio from the manifest, loaded on demand; fonts load up front
+    AssetRegistry assets;
 } TextureManager;
 
 int texture_manager_init(TextureManager* tm, SDL_Renderer* renderer);
 void texture_manager_cleanup(TextureManager* tm);
 SDL_Texture* load_texture(SDL_Renderer* renderer, const char* path, int* width, int* height);
 void render_texture(SDL_Renderer* renderer, SDL_Texture* texture, int x, int y, int width, int height);
+
+// Queues a texture, or its region of a shared page, on tm->sprites
+void draw_sprite(TextureManager* tm, const Texture* sprite, int x, int y, int width, int height);
 SDL_Texture* create_text_texture(SDL_Renderer* renderer, TTF_Font* font, const char* text, SDL_Color color, int* width, int* height);
 
+// Cached text: the returned texture is owned by the cache, do not destroy it
+SDL_Texture* get_text_texture(TextureManager* tm, TTF_Font* font, const char* text, SDL_Color color, int* width, int* height);
+void text_cache_clear(TextCache* cache);
+
+// Text drawn from the font's glyph atlas, falling back to the text cache.
+// Text is queued on tm->sprites, flush it before drawing over text directly.
+void measure_text(TextureManager* tm, TTF_Font* font, const char* text, int* width, int* height);
+void draw_text(TextureManager* tm, TTF_Font* font, const char* text, int x, int y, SDL_Color color);
+
 // Audio functions
+// Allocates the voices and starts counting late mix callbacks; needs the mixer open
+void audio_init(int chunk_size);
+void audio_cleanup(void);
+// Streams the track from disk, preferring a compressed .ogg next to a .wav
+Mix_Music* load_music(const char* path);
 void play_bgm(Mix_Music* music);
 void stop_bgm(void);
-void play_sfx(Mix_Chunk* chunk);
+void play_sfx(Mix_Chunk* chunk, int priority);
 
 #endif
\ No newline at end of file
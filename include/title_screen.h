@@ -14,9 +14,19 @@ typedef struct {
     MenuOption current_option;
     float arrow_rotation;
     TextureManager* texture_manager;
+    bool shown;           // First full frame drawn, logged for startup timing
+    
+    // Held for as long as the title screen exists
+    AssetId background;
+    AssetId logo;
+    AssetId dashie;
+    AssetId arrow;
+    AssetId menu_select;
+    AssetId bgm;
 } TitleScreen;
 
 void title_screen_init(TitleScreen* ts, TextureManager* tm);
+void title_screen_cleanup(TitleScreen* ts);
 void title_screen_handle_input(TitleScreen* ts, SDL_Event* e, int* next_state);
 void title_screen_update(TitleScreen* ts, float delta_time);
 void title_screen_render(TitleScreen* ts, SDL_Renderer* renderer);
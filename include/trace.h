@@ -0,0 +1,67 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <SDL.h>
+#include <stdbool.h>
+
+// Scoped timing markers exported as Chrome trace JSON, for chrome://tracing
+// or ui.perfetto.dev. Built with `make TRACE=1`; otherwise every TRACE_*
+// macro expands to nothing and no trace code runs.
+//
+//     void brick_grid_render(...) {
+//         TRACE_SCOPE("brick_grid_render");
+//
+// Names must be string literals, they are stored by pointer. F4 writes the
+// events so far to brickout-trace-N.json and exit writes brickout-trace.json.
+#define TRACE_RING_EVENTS 65536 // Per thread; the oldest are overwritten
+#define TRACE_MAX_THREADS 16
+#define TRACE_FILE "brickout-trace.json"
+
+typedef struct {
+    const char* name;
+    Uint64 start;         // Performance counter ticks
+    Uint64 duration;
+} TraceEvent;
+
+// Written only by its own thread. head counts every event ever written, and
+// is published after the event so a reader never sees a half-written one.
+typedef struct {
+    TraceEvent events[TRACE_RING_EVENTS];
+    SDL_atomic_t head;
+    SDL_threadID thread_id;
+    const char* thread_name;
+} TraceRing;
+
+typedef struct {
+    const char* name;
+    Uint64 start;
+} TraceScope;
+
+void trace_init(void);
+void trace_shutdown(void);
+void trace_set_thread_name(const char* name);
+TraceScope trace_scope_begin(const char* name);
+void trace_scope_end(TraceScope* scope);
+// path may be NULL for the next numbered file
+bool trace_dump(const char* path);
+
+#if defined(BRICKOUT_TRACE) && defined(__GNUC__)
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+// Times the rest of the enclosing block, ending on any return
+#define TRACE_SCOPE(name) \
+    TraceScope TRACE_CONCAT(trace_scope_, __LINE__) \
+        __attribute__((cleanup(trace_scope_end))) = trace_scope_begin(name)
+#define TRACE_INIT() trace_init()
+#define TRACE_SHUTDOWN() trace_shutdown()
+#define TRACE_THREAD_NAME(name) trace_set_thread_name(name)
+#define TRACE_DUMP(path) trace_dump(path)
+#else
+#define TRACE_SCOPE(name) ((void)0)
+#define TRACE_INIT() ((void)0)
+#define TRACE_SHUTDOWN() ((void)0)
+#define TRACE_THREAD_NAME(name) ((void)0)
+#define TRACE_DUMP(path) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,195 @@
+#include "asset_loader.h"
+#include "log.h"
+#include "trace.h"
+#include <stdio.h>
+#include <string.h>
+
+static int asset_loader_worker(void* data) {
+    AssetLoader* loader = data;
+    TRACE_THREAD_NAME("asset_loader");
+    
+    SDL_LockMutex(loader->lock);
+    while (!loader->quit) {
+        if (loader->queue_count == 0) {
+            SDL_CondWait(loader->work_ready, loader->lock);
+            continue;
+        }
+        
+        int index = loader->queue[loader->queue_head];
+        loader->queue_head = (loader->queue_head + 1) % ASSET_LOADER_MAX_JOBS;
+        loader->queue_count--;
+        SDL_UnlockMutex(loader->lock);
+        
+        AssetJob* job = &loader->jobs[index];
+        {
+            TRACE_SCOPE("decode_asset");
+            job->decode(job, loader->user_data);
+        }
+        
+        SDL_LockMutex(loader->lock);
+        loader->decoded[loader->decoded_count++] = index;
+        SDL_CondSignal(loader->job_decoded);
+    }
+    SDL_UnlockMutex(loader->lock);
+    return 0;
+}
+
+static void asset_loader_finish(AssetLoader* loader, int index) {
+    AssetJob* job = &loader->jobs[index];
+    job->finish(job, loader->user_data);
+    job->in_use = false;
+    loader->pending--;
+    loader->batch_jobs++;
+    
+    if (loader->pending == 0) {
+        double elapsed_ms = (double)(SDL_GetPerformanceCounter() - loader->batch_start) * 1000.0 /
+                            (double)SDL_GetPerformanceFrequency();
+        LOG_INFO(LOG_ASSETS, "Loaded %d asset(s) in %.1f ms on %d worker(s)",
+                 loader->batch_jobs, elapsed_ms, loader->worker_count);
+        loader->batch_jobs = 0;
+    }
+}
+
+int asset_loader_init(AssetLoader* loader, void* user_data) {
+    memset(loader, 0, sizeof(*loader));
+    loader->user_data = user_data;
+    loader->lock = SDL_CreateMutex();
+    loader->work_ready = SDL_CreateCond();
+    loader->job_decoded = SDL_CreateCond();
+    if (!loader->lock || !loader->work_ready || !loader->job_decoded) {
+        LOG_WARN(LOG_ASSETS, "Unable to create asset loader sync objects: %s", SDL_GetError());
+        asset_loader_cleanup(loader);
+        return -1;
+    }
+    
+    // Leave a core for the render thread
+    int count = SDL_GetCPUCount() - 1;
+    if (count < 1) count = 1;
+    if (count > ASSET_LOADER_MAX_WORKERS) count = ASSET_LOADER_MAX_WORKERS;
+    
+    for (int i = 0; i < count; i++) {
+        SDL_Thread* thread = SDL_CreateThread(asset_loader_worker, "asset_loader", loader);
+        if (!thread) {
+            LOG_WARN(LOG_ASSETS, "Unable to start asset worker: %s", SDL_GetError());
+            break;
+        }
+        loader->workers[loader->worker_count++] = thread;
+    }
+    
+    if (loader->worker_count == 0) {
+        return -1;
+    }
+    LOG_DEBUG(LOG_ASSETS, "Started %d asset worker(s)", loader->worker_count);
+    return 0;
+}
+
+bool asset_loader_add(AssetLoader* loader, const char* path, void* target,
+                      AssetDecodeFunc decode, AssetFinishFunc finish) {
+    int index = -1;
+    for (int i = 0; i < ASSET_LOADER_MAX_JOBS; i++) {
+        if (!loader->jobs[i].in_use) {
+            index = i;
+            break;
+        }
+    }
+    if (index < 0) {
+        LOG_WARN(LOG_ASSETS, "Asset loader full, skipping %s", path);
+        return false;
+    }
+    
+    if (loader->pending == 0) {
+        loader->batch_start = SDL_GetPerformanceCounter();
+    }
+    loader->pending++;
+    
+    // Without workers nothing else touches the queue, and there may be no lock
+    if (loader->lock) SDL_LockMutex(loader->lock);
+    AssetJob* job = &loader->jobs[index];
+    job->path = path;
+    job->target = target;
+    job->result = NULL;
+    job->decode = decode;
+    job->finish = finish;
+    job->in_use = true;
+    loader->queue[(loader->queue_head + loader->queue_count) % ASSET_LOADER_MAX_JOBS] = index;
+    loader->queue_count++;
+    if (loader->lock) {
+        SDL_CondSignal(loader->work_ready);
+        SDL_UnlockMutex(loader->lock);
+    }
+    return true;
+}
+
+void asset_loader_poll(AssetLoader* loader) {
+    if (loader->pending == 0) return;
+    
+    // Without workers, decode one job per frame so the window stays responsive
+    if (loader->worker_count == 0) {
+        int index = loader->queue[loader->queue_head];
+        loader->queue_head = (loader->queue_head + 1) % ASSET_LOADER_MAX_JOBS;
+        loader->queue_count--;
+        loader->jobs[index].decode(&loader->jobs[index], loader->user_data);
+        asset_loader_finish(loader, index);
+        return;
+    }
+    
+    int ready[ASSET_LOADER_MAX_JOBS];
+    int ready_count = 0;
+    SDL_LockMutex(loader->lock);
+    ready_count = loader->decoded_count;
+    memcpy(ready, loader->decoded, ready_count * sizeof(int));
+    loader->decoded_count = 0;
+    SDL_UnlockMutex(loader->lock);
+    
+    for (int i = 0; i < ready_count; i++) {
+        asset_loader_finish(loader, ready[i]);
+    }
+}
+
+void asset_loader_wait_one(AssetLoader* loader) {
+    if (loader->pending == 0) return;
+    if (loader->worker_count > 0) {
+        SDL_LockMutex(loader->lock);
+        if (loader->decoded_count == 0) {
+            SDL_CondWait(loader->job_decoded, loader->lock);
+        }
+        SDL_UnlockMutex(loader->lock);
+    }
+    asset_loader_poll(loader);
+}
+
+void asset_loader_wait(AssetLoader* loader) {
+    while (loader->pending > 0) {
+        asset_loader_wait_one(loader);
+    }
+}
+
+bool asset_loader_busy(const AssetLoader* loader) {
+    return loader->pending > 0;
+}
+
+void asset_loader_cleanup(AssetLoader* loader) {
+    // Let in-flight jobs finish so every decoded result gets an owner
+    if (loader->lock) {
+        SDL_LockMutex(loader->lock);
+        loader->quit = true;
+        SDL_CondBroadcast(loader->work_ready);
+        SDL_UnlockMutex(loader->lock);
+    }
+    for (int i = 0; i < loader->worker_count; i++) {
+        SDL_WaitThread(loader->workers[i], NULL);
+    }
+    loader->worker_count = 0;
+    
+    for (int i = 0; i < loader->decoded_count; i++) {
+        asset_loader_finish(loader, loader->decoded[i]);
+    }
+    loader->decoded_count = 0;
+    
+    if (loader->job_decoded) SDL_DestroyCond(loader->job_decoded);
+    if (loader->work_ready) SDL_DestroyCond(loader->work_ready);
+    if (loader->lock) SDL_DestroyMutex(loader->lock);
+    loader->job_decoded = NULL;
+    loader->work_ready = NULL;
+    loader->lock = NULL;
+}
@@ -0,0 +1,141 @@
+// mmap and friends are POSIX, hidden by -std=c99 otherwise
+#define _POSIX_C_SOURCE 200809L
+
+#include "asset_pack.h"
+#include "log.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <stdlib.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static void* asset_pack_map(const char* path, size_t* size) {
+#ifdef _WIN32
+    // No mmap here, read the file in one go instead
+    return SDL_LoadFile(path, size);
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+    
+    struct stat st;
+    void* data = NULL;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            data = NULL;
+        } else {
+            *size = (size_t)st.st_size;
+        }
+    }
+    close(fd);
+    return data;
+#endif
+}
+
+static void asset_pack_unmap(void* data, size_t size) {
+#ifdef _WIN32
+    (void)size;
+    SDL_free(data);
+#else
+    munmap(data, size);
+#endif
+}
+
+int asset_pack_open(AssetPack* pack, const char* path) {
+    memset(pack, 0, sizeof(*pack));
+    
+    Uint64 start = SDL_GetPerformanceCounter();
+    size_t size = 0;
+    void* data = asset_pack_map(path, &size);
+    if (!data) {
+        return -1;
+    }
+    
+    const AssetPackHeader* header = data;
+    if (size < sizeof(AssetPackHeader) || header->magic != ASSET_PACK_MAGIC ||
+        header->version != ASSET_PACK_VERSION ||
+        size < sizeof(AssetPackHeader) + (size_t)header->entry_count * sizeof(AssetPackEntry)) {
+        LOG_WARN(LOG_ASSETS, "%s is not a usable asset pack, rebuild it with `make pack`", path);
+        asset_pack_unmap(data, size);
+        return -1;
+    }
+    
+    const AssetPackEntry* entries = (const AssetPackEntry*)(header + 1);
+    for (Uint32 i = 0; i < header->entry_count; i++) {
+        if (entries[i].offset > size || entries[i].size > size - entries[i].offset) {
+            LOG_WARN(LOG_ASSETS, "%s is truncated, rebuild it with `make pack`", path);
+            asset_pack_unmap(data, size);
+            return -1;
+        }
+    }
+    
+    pack->data = data;
+    pack->size = size;
+    pack->header = header;
+    pack->entries = entries;
+    
+    // Sound effects are only usable if the mixer opened in the packed format
+    int frequency = 0, channels = 0;
+    Uint16 format = 0;
+    if (Mix_QuerySpec(&frequency, &format, &channels)) {
+        pack->pcm_usable = true;
+        for (Uint32 i = 0; i < header->entry_count; i++) {
+            if (entries[i].kind == ASSET_PACK_PCM &&
+                ((int)entries[i].frequency != frequency || entries[i].format != format ||
+                 (int)entries[i].channels != channels)) {
+                LOG_WARN(LOG_ASSETS, "Packed SFX don't match the mixer format, decoding them instead");
+                pack->pcm_usable = false;
+                break;
+            }
+        }
+    }
+    
+    double elapsed_ms = (double)(SDL_GetPerformanceCounter() - start) * 1000.0 /
+                        (double)SDL_GetPerformanceFrequency();
+    LOG_INFO(LOG_ASSETS, "Mapped asset pack %s (%u entries, %zu KB) in %.2f ms",
+             path, header->entry_count, size / 1024, elapsed_ms);
+    return 0;
+}
+
+void asset_pack_close(AssetPack* pack) {
+    if (pack->data) {
+        asset_pack_unmap(pack->data, pack->size);
+    }
+    memset(pack, 0, sizeof(*pack));
+}
+
+const AssetPackEntry* asset_pack_find(const AssetPack* pack, const char* path, AssetPackKind kind) {
+    if (!pack->data || !path) return NULL;
+    if (kind == ASSET_PACK_PCM && !pack->pcm_usable) return NULL;
+    
+    // A couple of dozen entries, a linear scan is plenty
+    for (Uint32 i = 0; i < pack->header->entry_count; i++) {
+        const AssetPackEntry* entry = &pack->entries[i];
+        if (entry->kind == (Uint32)kind && strncmp(entry->path, path, ASSET_PACK_PATH_MAX) == 0) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+const void* asset_pack_data(const AssetPack* pack, const AssetPackEntry* entry) {
+    return (const Uint8*)pack->data + entry->offset;
+}
+
+SDL_Surface* asset_pack_surface(const AssetPack* pack, const AssetPackEntry* entry) {
+    // SDL never writes through a surface we only upload or blit from
+    return SDL_CreateRGBSurfaceWithFormatFrom((void*)asset_pack_data(pack, entry),
+                                              (int)entry->width, (int)entry->height, 32,
+                                              (int)entry->pitch, SDL_PIXELFORMAT_RGBA32);
+}
+
+Mix_Chunk* asset_pack_chunk(const AssetPack* pack, const AssetPackEntry* entry) {
+    // QuickLoad keeps pointing at the mapping and won't free it with the chunk
+    return Mix_QuickLoad_RAW((Uint8*)asset_pack_data(pack, entry), (Uint32)entry->size);
+}
@@ -0,0 +1,631 @@
+#include "asset_registry.h"
+#include "log.h"
+#include "texture_manager.h"
+#include <SDL_image.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const Texture empty_texture;
+
+typedef struct {
+    SDL_Surface* page;
+    SDL_Rect placed[ASSET_MAX]; // By asset id; empty for non-sprites
+} SpritePageResult;
+
+static Uint32 asset_hash(const char* name) {
+    // FNV-1a
+    Uint32 hash = 2166136261u;
+    for (const unsigned char* p = (const unsigned char*)name; *p; p++) {
+        hash ^= *p;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static const char* asset_type_names[ASSET_TYPE_COUNT] = {"images", "sprites", "music", "sounds"};
+
+static void asset_track_memory(AssetRegistry* reg, AssetType type, size_t bytes, bool loaded) {
+    if (loaded) {
+        reg->resident_bytes[type] += bytes;
+        reg->resident_total += bytes;
+        if (reg->resident_bytes[type] > reg->peak_bytes[type]) {
+            reg->peak_bytes[type] = reg->resident_bytes[type];
+        }
+        if (reg->resident_total > reg->peak_total) {
+            reg->peak_total = reg->resident_total;
+        }
+    } else {
+        reg->resident_bytes[type] -= bytes;
+        reg->resident_total -= bytes;
+    }
+}
+
+static bool asset_valid(const AssetRegistry* reg, AssetId id) {
+    return id >= 0 && id < reg->count;
+}
+
+AssetId asset_find(const AssetRegistry* reg, const char* name) {
+    if (!name) return ASSET_ID_NONE;
+    
+    Uint32 slot = asset_hash(name) & (ASSET_HASH_SIZE - 1);
+    while (reg->hash[slot] != ASSET_ID_NONE) {
+        AssetId id = reg->hash[slot];
+        if (strcmp(reg->assets[id].name, name) == 0) {
+            return id;
+        }
+        slot = (slot + 1) & (ASSET_HASH_SIZE - 1);
+    }
+    return ASSET_ID_NONE;
+}
+
+static bool asset_intern(AssetRegistry* reg, AssetType type, const char* name, const char* path) {
+    if (reg->count >= ASSET_MAX) {
+        LOG_WARN(LOG_ASSETS, "Asset manifest has more than %d entries, ignoring %s", ASSET_MAX, name);
+        return false;
+    }
+    if (strlen(name) >= ASSET_NAME_MAX || strlen(path) >= ASSET_PACK_PATH_MAX) {
+        LOG_WARN(LOG_ASSETS, "Asset name or path too long, ignoring %s", name);
+        return false;
+    }
+    if (asset_find(reg, name) != ASSET_ID_NONE) {
+        LOG_WARN(LOG_ASSETS, "Duplicate asset %s in manifest", name);
+        return false;
+    }
+    
+    AssetId id = reg->count++;
+    Asset* asset = &reg->assets[id];
+    memset(asset, 0, sizeof(*asset));
+    strcpy(asset->name, name);
+    strcpy(asset->path, path);
+    asset->type = type;
+    asset->state = ASSET_UNLOADED;
+    
+    Uint32 slot = asset_hash(name) & (ASSET_HASH_SIZE - 1);
+    while (reg->hash[slot] != ASSET_ID_NONE) {
+        slot = (slot + 1) & (ASSET_HASH_SIZE - 1);
+    }
+    reg->hash[slot] = (Sint16)id;
+    return true;
+}
+
+static int asset_registry_read_manifest(AssetRegistry* reg, const char* manifest_path) {
+    FILE* file = fopen(manifest_path, "r");
+    if (!file) {
+        LOG_ERROR(LOG_ASSETS, "Unable to open asset manifest %s", manifest_path);
+        return -1;
+    }
+    
+    char line[256];
+    int line_number = 0;
+    while (fgets(line, sizeof(line), file)) {
+        line_number++;
+        line[strcspn(line, "\r\n")] = '\0';
+        
+        char type_name[16];
+        char name[ASSET_NAME_MAX + 1];
+        int path_start = 0;
+        if (line[0] == '#' || sscanf(line, "%15s %32s %n", type_name, name, &path_start) < 2) {
+            continue; // Comments and blank lines
+        }
+        
+        // Sounds may set a voice priority ahead of the path
+        const char* path = line + path_start;
+        int priority = SFX_PRIORITY_DEFAULT;
+        int consumed = 0;
+        if (path_start > 0 && sscanf(path, "priority=%d %n", &priority, &consumed) == 1 && consumed > 0) {
+            path += consumed;
+        }
+        
+        // The path runs to the end of the line and may contain spaces
+        if (path_start == 0 || *path == '\0') {
+            LOG_WARN(LOG_ASSETS, "%s:%d has no path", manifest_path, line_number);
+            continue;
+        }
+        
+        AssetType type;
+        if (strcmp(type_name, "image") == 0) {
+            type = ASSET_TYPE_IMAGE;
+        } else if (strcmp(type_name, "sprite") == 0) {
+            type = ASSET_TYPE_SPRITE;
+        } else if (strcmp(type_name, "music") == 0) {
+            type = ASSET_TYPE_MUSIC;
+        } else if (strcmp(type_name, "sound") == 0) {
+            type = ASSET_TYPE_SOUND;
+        } else {
+            LOG_WARN(LOG_ASSETS, "%s:%d has unknown asset type %s", manifest_path, line_number, type_name);
+            continue;
+        }
+        if (asset_intern(reg, type, name, path)) {
+            reg->assets[reg->count - 1].priority = priority;
+        }
+    }
+    
+    fclose(file);
+    LOG_DEBUG(LOG_ASSETS, "Asset manifest lists %d assets", reg->count);
+    return 0;
+}
+
+// Pixels straight from the asset pack when it has them, otherwise decoded
+static SDL_Surface* load_image_surface(const AssetPack* pack, const char* path) {
+    const AssetPackEntry* entry = asset_pack_find(pack, path, ASSET_PACK_IMAGE);
+    if (entry) {
+        return asset_pack_surface(pack, entry);
+    }
+    
+    SDL_Surface* surface = IMG_Load(path);
+    if (!surface) {
+        LOG_ERROR(LOG_ASSETS, "Unable to load image %s! SDL_image Error: %s", path, IMG_GetError());
+    }
+    return surface;
+}
+
+// Worker thread: decode every sprite in the manifest and shelf-pack them into one surface
+static void decode_sprite_page(AssetJob* job, void* user_data) {
+    AssetRegistry* reg = user_data;
+    SpritePageResult* result = calloc(1, sizeof(SpritePageResult));
+    if (!result) return;
+    job->result = result;
+    
+    SDL_Surface* surfaces[ASSET_MAX] = {NULL};
+    int order[ASSET_MAX];
+    int sprite_count = 0;
+    
+    for (AssetId id = 0; id < reg->count; id++) {
+        if (reg->assets[id].type != ASSET_TYPE_SPRITE) continue;
+        order[sprite_count++] = id;
+        
+        SDL_Surface* loaded = load_image_surface(&reg->pack, reg->assets[id].path);
+        if (!loaded) continue;
+        surfaces[id] = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+        SDL_FreeSurface(loaded);
+        if (surfaces[id]) {
+            // Copy pixels as-is rather than blending them onto the empty page
+            SDL_SetSurfaceBlendMode(surfaces[id], SDL_BLENDMODE_NONE);
+        }
+    }
+    
+    // Tallest first keeps the shelves tight
+    for (int i = 1; i < sprite_count; i++) {
+        int current = order[i];
+        int h = surfaces[current] ? surfaces[current]->h : 0;
+        int j = i - 1;
+        while (j >= 0 && (surfaces[order[j]] ? surfaces[order[j]]->h : 0) < h) {
+            order[j + 1] = order[j];
+            j--;
+        }
+        order[j + 1] = current;
+    }
+    
+    int pen_x = 0;
+    int pen_y = 0;
+    int shelf_height = 0;
+    for (int k = 0; k < sprite_count; k++) {
+        int id = order[k];
+        if (!surfaces[id]) continue;
+        
+        SDL_Rect rect = {0, 0, surfaces[id]->w, surfaces[id]->h};
+        if (pen_x + rect.w > SPRITE_PAGE_WIDTH) {
+            pen_x = 0;
+            pen_y += shelf_height + SPRITE_PAGE_PADDING;
+            shelf_height = 0;
+        }
+        rect.x = pen_x;
+        rect.y = pen_y;
+        pen_x += rect.w + SPRITE_PAGE_PADDING;
+        if (rect.h > shelf_height) shelf_height = rect.h;
+        result->placed[id] = rect;
+    }
+    
+    int page_height = pen_y + shelf_height;
+    if (page_height > 0) {
+        result->page = SDL_CreateRGBSurfaceWithFormat(0, SPRITE_PAGE_WIDTH, page_height, 32, SDL_PIXELFORMAT_RGBA32);
+    }
+    if (result->page) {
+        SDL_FillRect(result->page, NULL, 0);
+        for (int k = 0; k < sprite_count; k++) {
+            int id = order[k];
+            if (surfaces[id]) {
+                SDL_Rect dest_rect = result->placed[id];
+                SDL_BlitSurface(surfaces[id], NULL, result->page, &dest_rect);
+            }
+        }
+    }
+    
+    for (int k = 0; k < sprite_count; k++) {
+        if (surfaces[order[k]]) {
+            SDL_FreeSurface(surfaces[order[k]]);
+        }
+    }
+}
+
+static void asset_registry_unload_page(AssetRegistry* reg) {
+    for (AssetId id = 0; id < reg->count; id++) {
+        Asset* asset = &reg->assets[id];
+        if (asset->type != ASSET_TYPE_SPRITE) continue;
+        
+        // Sprites only borrow the page unless it couldn't be built
+        if (asset->texture.texture && asset->texture.texture != reg->sprite_page) {
+            SDL_DestroyTexture(asset->texture.texture);
+        }
+        memset(&asset->texture, 0, sizeof(asset->texture));
+        asset->state = ASSET_UNLOADED;
+    }
+    if (reg->sprite_page) {
+        SDL_DestroyTexture(reg->sprite_page);
+        reg->sprite_page = NULL;
+    }
+    asset_track_memory(reg, ASSET_TYPE_SPRITE, reg->resident_bytes[ASSET_TYPE_SPRITE], false);
+    reg->page_state = ASSET_UNLOADED;
+}
+
+// Render thread: upload the page and point each sprite at its region
+static void finish_sprite_page(AssetJob* job, void* user_data) {
+    AssetRegistry* reg = user_data;
+    SpritePageResult* result = job->result;
+    
+    if (result && result->page) {
+        reg->sprite_page = SDL_CreateTextureFromSurface(reg->renderer, result->page);
+        if (!reg->sprite_page) {
+            LOG_ERROR(LOG_ASSETS, "Unable to create sprite page texture! SDL Error: %s", SDL_GetError());
+        } else {
+            SDL_SetTextureBlendMode(reg->sprite_page, SDL_BLENDMODE_BLEND);
+            asset_track_memory(reg, ASSET_TYPE_SPRITE, (size_t)result->page->w * result->page->h * 4, true);
+            LOG_DEBUG(LOG_ASSETS, "Packed sprites into a %dx%d page", result->page->w, result->page->h);
+        }
+    }
+    
+    for (AssetId id = 0; id < reg->count; id++) {
+        Asset* asset = &reg->assets[id];
+        if (asset->type != ASSET_TYPE_SPRITE) continue;
+        
+        Texture* sprite = &asset->texture;
+        if (reg->sprite_page) {
+            if (result->placed[id].w > 0) {
+                sprite->texture = reg->sprite_page;
+                sprite->src = result->placed[id];
+                sprite->width = result->placed[id].w;
+                sprite->height = result->placed[id].h;
+            }
+        } else {
+            sprite->texture = load_texture(reg->renderer, asset->path, &sprite->width, &sprite->height);
+            if (sprite->texture) {
+                SDL_Rect whole = {0, 0, sprite->width, sprite->height};
+                sprite->src = whole;
+                asset_track_memory(reg, ASSET_TYPE_SPRITE, (size_t)sprite->width * sprite->height * 4, true);
+            }
+        }
+        asset->state = sprite->texture ? ASSET_LOADED : ASSET_FAILED;
+        if (!sprite->texture) {
+            LOG_WARN(LOG_ASSETS, "Failed to load %s", asset->path);
+        }
+    }
+    reg->page_state = ASSET_LOADED;
+    if (!reg->sprite_page) {
+        LOG_WARN(LOG_ASSETS, "Sprite page unavailable, loaded sprites individually");
+    }
+    
+    if (result) {
+        if (result->page) SDL_FreeSurface(result->page);
+        free(result);
+    }
+    job->result = NULL;
+    
+    // Everyone let go while it was loading
+    if (reg->sprite_refs == 0) {
+        asset_registry_unload_page(reg);
+    }
+}
+
+static void decode_asset(AssetJob* job, void* user_data) {
+    AssetRegistry* reg = user_data;
+    Asset* asset = job->target;
+    const AssetPackEntry* entry;
+    
+    switch (asset->type) {
+        case ASSET_TYPE_IMAGE:
+            job->result = load_image_surface(&reg->pack, asset->path);
+            break;
+        case ASSET_TYPE_MUSIC:
+            job->result = load_music(asset->path);
+            break;
+        case ASSET_TYPE_SOUND:
+            entry = asset_pack_find(&reg->pack, asset->path, ASSET_PACK_PCM);
+            job->result = entry ? asset_pack_chunk(&reg->pack, entry) : sfx_cache_load(&reg->sfx_cache, asset->path);
+            if (!job->result) {
+                LOG_WARN(LOG_ASSETS, "Failed to load SFX %s: %s", asset->path, Mix_GetError());
+            }
+            break;
+        case ASSET_TYPE_SPRITE:
+        case ASSET_TYPE_COUNT:
+            break;
+    }
+}
+
+static void asset_unload(AssetRegistry* reg, Asset* asset) {
+    if (asset->type == ASSET_TYPE_SPRITE) return; // Goes with the page
+    
+    if (asset->state == ASSET_LOADED) {
+        asset_track_memory(reg, asset->type, asset->bytes, false);
+        asset->bytes = 0;
+    }
+    switch (asset->type) {
+        case ASSET_TYPE_IMAGE:
+            if (asset->texture.texture) {
+                SDL_DestroyTexture(asset->texture.texture);
+            }
+            memset(&asset->texture, 0, sizeof(asset->texture));
+            break;
+        case ASSET_TYPE_MUSIC:
+            if (asset->music) {
+                Mix_FreeMusic(asset->music);
+                asset->music = NULL;
+            }
+            break;
+        case ASSET_TYPE_SOUND:
+            if (asset->chunk) {
+                Mix_FreeChunk(asset->chunk);
+                asset->chunk = NULL;
+            }
+            break;
+        case ASSET_TYPE_SPRITE:
+        case ASSET_TYPE_COUNT:
+            break;
+    }
+    
+    // A missing file isn't looked for again every time a screen comes back
+    if (asset->state != ASSET_FAILED) {
+        asset->state = ASSET_UNLOADED;
+    }
+}
+
+static void finish_asset(AssetJob* job, void* user_data) {
+    AssetRegistry* reg = user_data;
+    Asset* asset = job->target;
+    AssetId id = (AssetId)(asset - reg->assets);
+    
+    switch (asset->type) {
+        case ASSET_TYPE_IMAGE: {
+            SDL_Surface* surface = job->result;
+            if (surface) {
+                asset->texture.texture = SDL_CreateTextureFromSurface(reg->renderer, surface);
+                if (!asset->texture.texture) {
+                    LOG_ERROR(LOG_ASSETS, "Unable to create texture from %s! SDL Error: %s", asset->path, SDL_GetError());
+                } else {
+                    asset->texture.width = surface->w;
+                    asset->texture.height = surface->h;
+                    asset->bytes = (size_t)surface->w * surface->h * 4;
+                }
+                SDL_FreeSurface(surface);
+            } else {
+                LOG_WARN(LOG_ASSETS, "Failed to load %s", asset->path);
+            }
+            asset->state = asset->texture.texture ? ASSET_LOADED : ASSET_FAILED;
+            break;
+        }
+        case ASSET_TYPE_MUSIC:
+            asset->music = job->result;
+            asset->state = asset->music ? ASSET_LOADED : ASSET_FAILED;
+            if (asset->music) {
+                asset->bytes = MUSIC_STREAM_CHUNK; // Read buffer; decoder state isn't counted
+            }
+            break;
+        case ASSET_TYPE_SOUND:
+            asset->chunk = job->result;
+            asset->state = asset->chunk ? ASSET_LOADED : ASSET_FAILED;
+            if (asset->chunk) {
+                asset->bytes = asset->chunk->alen;
+            }
+            break;
+        case ASSET_TYPE_SPRITE:
+        case ASSET_TYPE_COUNT:
+            break;
+    }
+    job->result = NULL;
+    if (asset->state == ASSET_LOADED) {
+        asset_track_memory(reg, asset->type, asset->bytes, true);
+    }
+    
+    // Released while it was loading, say a prefetch that was skipped past
+    if (asset->refcount == 0) {
+        if (reg->pending_music == id) {
+            reg->pending_music = ASSET_ID_NONE;
+        }
+        asset_unload(reg, asset);
+        return;
+    }
+    if (reg->pending_music == id) {
+        reg->pending_music = ASSET_ID_NONE;
+        play_bgm(asset->music);
+    }
+}
+
+int asset_registry_init(AssetRegistry* reg, SDL_Renderer* renderer, const char* manifest_path) {
+    memset(reg, 0, sizeof(*reg));
+    reg->renderer = renderer;
+    reg->page_state = ASSET_UNLOADED;
+    reg->pending_music = ASSET_ID_NONE;
+    for (int i = 0; i < ASSET_HASH_SIZE; i++) {
+        reg->hash[i] = ASSET_ID_NONE;
+    }
+    
+    if (asset_registry_read_manifest(reg, manifest_path) != 0) {
+        return -1;
+    }
+    
+    // BRICKOUT_NO_PACK=1 forces the source files, for comparing startup times
+    const char* no_pack = SDL_getenv("BRICKOUT_NO_PACK");
+    if (no_pack && *no_pack && *no_pack != '0') {
+        LOG_INFO(LOG_ASSETS, "Asset pack disabled, decoding source files");
+    } else if (asset_pack_open(&reg->pack, ASSET_PACK_FILE) != 0) {
+        LOG_INFO(LOG_ASSETS, "No asset pack, decoding source files");
+    }
+    sfx_cache_init(&reg->sfx_cache);
+    
+    // Loading still completes without workers, one asset per frame
+    if (asset_loader_init(&reg->loader, reg) != 0) {
+        LOG_WARN(LOG_ASSETS, "No asset workers, decoding on the render thread");
+    }
+    return 0;
+}
+
+void asset_registry_cleanup(AssetRegistry* reg) {
+    // Workers must be stopped before anything they might still write to goes
+    asset_loader_cleanup(&reg->loader);
+    sfx_cache_report(&reg->sfx_cache);
+    
+    char peaks[128];
+    size_t used = 0;
+    for (int type = 0; type < ASSET_TYPE_COUNT && used < sizeof(peaks); type++) {
+        used += (size_t)snprintf(peaks + used, sizeof(peaks) - used, "%s %s %.1f MiB",
+                                 type > 0 ? "," : "", asset_type_names[type],
+                                 reg->peak_bytes[type] / (1024.0 * 1024.0));
+    }
+    LOG_INFO(LOG_ASSETS, "Asset memory high-water mark: %.1f MiB (peaks:%s)",
+             reg->peak_total / (1024.0 * 1024.0), peaks);
+    
+    int leaked = 0;
+    for (AssetId id = 0; id < reg->count; id++) {
+        if (reg->assets[id].refcount > 0) {
+            leaked++;
+        }
+        asset_unload(reg, &reg->assets[id]);
+        reg->assets[id].refcount = 0;
+    }
+    asset_registry_unload_page(reg);
+    if (leaked > 0) {
+        LOG_WARN(LOG_ASSETS, "%d asset(s) still referenced at shutdown", leaked);
+    }
+    
+    // Packed images and chunks point into the mapping, so it goes last
+    asset_pack_close(&reg->pack);
+}
+
+void asset_registry_update(AssetRegistry* reg) {
+    asset_loader_poll(&reg->loader);
+}
+
+void asset_registry_wait(AssetRegistry* reg) {
+    asset_loader_wait(&reg->loader);
+}
+
+void asset_registry_wait_for(AssetRegistry* reg, const AssetId* ids, int count) {
+    for (;;) {
+        bool ready = true;
+        for (int i = 0; i < count && ready; i++) {
+            ready = asset_ready(reg, ids[i]);
+        }
+        // An asset whose load never started won't arrive however long we wait
+        if (ready || !asset_loader_busy(&reg->loader)) return;
+        asset_loader_wait_one(&reg->loader);
+    }
+}
+
+bool asset_registry_busy(const AssetRegistry* reg) {
+    return asset_loader_busy(&reg->loader);
+}
+
+float asset_registry_progress(const AssetRegistry* reg) {
+    int wanted = 0;
+    int settled = 0;
+    for (AssetId id = 0; id < reg->count; id++) {
+        const Asset* asset = &reg->assets[id];
+        if (asset->refcount == 0) continue;
+        wanted++;
+        if (asset->state == ASSET_LOADED || asset->state == ASSET_FAILED) {
+            settled++;
+        }
+    }
+    return wanted > 0 ? (float)settled / (float)wanted : 1.0f;
+}
+
+AssetId asset_acquire(AssetRegistry* reg, const char* name) {
+    AssetId id = asset_find(reg, name);
+    if (id == ASSET_ID_NONE) {
+        LOG_WARN(LOG_ASSETS, "Asset %s is not in the manifest", name);
+        return ASSET_ID_NONE;
+    }
+    
+    Asset* asset = &reg->assets[id];
+    asset->refcount++;
+    
+    if (asset->type == ASSET_TYPE_SPRITE) {
+        reg->sprite_refs++;
+        if (reg->page_state == ASSET_UNLOADED &&
+            asset_loader_add(&reg->loader, "sprite page", NULL, decode_sprite_page, finish_sprite_page)) {
+            reg->page_state = ASSET_LOADING;
+            for (AssetId i = 0; i < reg->count; i++) {
+                if (reg->assets[i].type == ASSET_TYPE_SPRITE) {
+                    reg->assets[i].state = ASSET_LOADING;
+                }
+            }
+        }
+    } else if (asset->state == ASSET_UNLOADED &&
+               asset_loader_add(&reg->loader, asset->path, asset, decode_asset, finish_asset)) {
+        asset->state = ASSET_LOADING;
+    }
+    return id;
+}
+
+void asset_release(AssetRegistry* reg, AssetId id) {
+    if (!asset_valid(reg, id) || reg->assets[id].refcount == 0) return;
+    
+    Asset* asset = &reg->assets[id];
+    asset->refcount--;
+    
+    if (asset->type == ASSET_TYPE_SPRITE) {
+        reg->sprite_refs--;
+        if (reg->sprite_refs == 0 && reg->page_state == ASSET_LOADED) {
+            asset_registry_unload_page(reg);
+        }
+        return;
+    }
+    
+    // Loads in flight are dropped when they finish
+    if (asset->refcount == 0 && asset->state != ASSET_LOADING) {
+        if (reg->pending_music == id) {
+            reg->pending_music = ASSET_ID_NONE;
+        }
+        if (asset->state == ASSET_LOADED) {
+            LOG_DEBUG(LOG_ASSETS, "Evicting %s (%zu KiB)", asset->name, asset->bytes / 1024);
+        }
+        asset_unload(reg, asset);
+    }
+}
+
+bool asset_ready(const AssetRegistry* reg, AssetId id) {
+    if (!asset_valid(reg, id)) return true; // Nothing will ever arrive
+    AssetState state = reg->assets[id].state;
+    return state == ASSET_LOADED || state == ASSET_FAILED;
+}
+
+const Texture* asset_texture(const AssetRegistry* reg, AssetId id) {
+    if (!asset_valid(reg, id)) return &empty_texture;
+    return &reg->assets[id].texture;
+}
+
+Mix_Music* asset_music(const AssetRegistry* reg, AssetId id) {
+    if (!asset_valid(reg, id)) return NULL;
+    return reg->assets[id].music;
+}
+
+Mix_Chunk* asset_sound(const AssetRegistry* reg, AssetId id) {
+    if (!asset_valid(reg, id)) return NULL;
+    return reg->assets[id].chunk;
+}
+
+void asset_play_music(AssetRegistry* reg, AssetId id) {
+    if (!asset_valid(reg, id)) return;
+    
+    if (reg->assets[id].state == ASSET_LOADING) {
+        reg->pending_music = id;
+        return;
+    }
+    reg->pending_music = ASSET_ID_NONE;
+    play_bgm(reg->assets[id].music);
+}
+
+void asset_play_sound(AssetRegistry* reg, AssetId id) {
+    if (!asset_valid(reg, id)) return;
+    play_sfx(reg->assets[id].chunk, reg->assets[id].priority);
+}
@@ -0,0 +1,64 @@
+#include "autoplay.h"
+#include "game.h"
+#include <math.h>
+
+#define AUTOPLAY_PADDLE_SPREAD 150.0f // vel_x at the paddle's edge, from gameplay_check_collisions
+#define AUTOPLAY_MAX_AIM 0.8f      // Share of the half paddle to aim with, keeping a margin
+#define AUTOPLAY_DEAD_ZONE 2.0f    // Pixels; closer than this counts as lined up
+
+// Where the ball's left edge will be after covering distance_x, folded
+// back off the side walls
+static float autoplay_fold_x(float x, float distance_x, float width) {
+    float span = WINDOW_WIDTH - width;
+    float folded = fmodf(x + distance_x, 2.0f * span);
+    if (folded < 0.0f) folded += 2.0f * span;
+    return folded > span ? 2.0f * span - folded : folded;
+}
+
+// The lowest standing brick is the one the ball can reach without
+// anything in the way; ties go to the one nearest the landing point
+static int autoplay_pick_brick(Gameplay* gp, float from_x) {
+    BrickGrid* grid = &gp->brick_grid;
+    int best = -1;
+    for (int i = 0; i < grid->count; i++) {
+        if (!brick_grid_is_live(grid, i)) continue;
+        if (best < 0 || grid->y[i] > grid->y[best] ||
+            (grid->y[i] == grid->y[best] &&
+             fabsf(grid->x[i] + grid->width[i] / 2 - from_x) <
+             fabsf(grid->x[best] + grid->width[best] / 2 - from_x))) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+void autoplay_input(Gameplay* gp, GameplayInput* input) {
+    Ball* ball = &gp->ball;
+    Paddle* paddle = &gp->paddle;
+    float half_paddle = paddle->width / 2.0f;
+    float paddle_center = paddle->x + half_paddle;
+    float target = ball->x + ball->width / 2.0f;
+    
+    if (ball->vel_y > 0.0f) {
+        // Meet the ball where it comes down, offset so it leaves towards a brick
+        float contact_y = paddle->y - ball->height;
+        float time = (contact_y - ball->y) / ball->vel_y;
+        float landing = autoplay_fold_x(ball->x, ball->vel_x * time, ball->width) + ball->width / 2.0f;
+        target = landing;
+    
+        int brick = autoplay_pick_brick(gp, landing);
+        if (brick >= 0 && time >= 0.0f) {
+            BrickGrid* grid = &gp->brick_grid;
+            float rise = contact_y - (grid->y[brick] + grid->height[brick]);
+            float run = grid->x[brick] + grid->width[brick] / 2.0f - landing;
+            float aim = rise > 0.0f ? run * ball->vel_y / rise / AUTOPLAY_PADDLE_SPREAD : 0.0f;
+            if (aim > AUTOPLAY_MAX_AIM) aim = AUTOPLAY_MAX_AIM;
+            if (aim < -AUTOPLAY_MAX_AIM) aim = -AUTOPLAY_MAX_AIM;
+            target = landing - aim * half_paddle;
+        }
+    }
+    
+    input->left = paddle_center > target + AUTOPLAY_DEAD_ZONE;
+    input->right = paddle_center < target - AUTOPLAY_DEAD_ZONE;
+    input->commands = 0;
+}
@@ -2,57 +2,67 @@
 #include "game.h"
 #include "texture_manager.h"
 #include <math.h>
-#include <stdlib.h>
-#include <time.h>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
-void ball_init(Ball* ball, float x, float y, SDL_Texture* texture) {
+void ball_init(Ball* ball, float x, float y) {
     ball->x = x;
     ball->y = y;
+    ball->prev_x = x;
+    ball->prev_y = y;
     ball->vel_x = 200.0f;  // Initial velocity
     ball->vel_y = -200.0f; // Moving upward initially
     ball->width = 16;
     ball->height = 16;
-    ball->texture = texture;
+    ball->sprite = NULL;
 }
 
-void ball_update(Ball* ball, float delta_time, TextureManager* tm) {
+bool ball_update(Ball* ball, float delta_time) {
     ball->x += ball->vel_x * delta_time;
     ball->y += ball->vel_y * delta_time;
     
+    return ball_check_walls(ball);
+}
+
+bool ball_check_walls(Ball* ball) {
+    bool bounced = false;
+    
     // Wall collision detection
     if (ball->x <= 0) {
         ball->x = 0;
-        ball_bounce_x(ball, tm);
+        ball_bounce_x(ball);
+        bounced = true;
     }
     if (ball->x + ball->width >= WINDOW_WIDTH) {
         ball->x = WINDOW_WIDTH - ball->width;
-        ball_bounce_x(ball, tm);
+        ball_bounce_x(ball);
+        bounced = true;
     }
     // Top boundary is below the UI header (60px)
     int header_height = 60;
     if (ball->y <= header_height) {
         ball->y = header_height;
-        ball_bounce_y(ball, tm);
+        ball_bounce_y(ball);
+        bounced = true;
     }
     
     // Ball goes off bottom - will be handled by game logic
+    return bounced;
 }
 
-void ball_render(Ball* ball, SDL_Renderer* renderer) {
-    if (ball->texture) {
-        SDL_Rect dest_rect = {
-            (int)ball->x, (int)ball->y, 
-            ball->width, ball->height
-        };
-        SDL_RenderCopy(renderer, ball->texture, NULL, &dest_rect);
+void ball_render(Ball* ball, SpriteBatch* batch, float alpha) {
+    if (ball->sprite && ball->sprite->texture) {
+        // Interpolate between the last two simulation steps
+        float x = ball->prev_x + (ball->x - ball->prev_x) * alpha;
+        float y = ball->prev_y + (ball->y - ball->prev_y) * alpha;
+        SDL_Color white = {255, 255, 255, 255};
+        sprite_batch_draw(batch, ball->sprite->texture, &ball->sprite->src, x, y, ball->width, ball->height, white);
     }
 }
 
-void ball_bounce_x(Ball* ball, TextureManager* tm) {
+void ball_bounce_x(Ball* ball) {
     ball->vel_x = -ball->vel_x;
     
     // Accelerate ball slightly (1% speed increase per bounce)
@@ -67,11 +77,9 @@ void ball_bounce_x(Ball* ball, TextureManager* tm) {
     if (fabs(ball->vel_y) > max_speed) {
         ball->vel_y = ball->vel_y > 0 ? max_speed : -max_speed;
     }
-    
-    play_sfx(tm->sfx_ball_wall);
 }
 
-void ball_bounce_y(Ball* ball, TextureManager* tm) {
+void ball_bounce_y(Ball* ball) {
     ball->vel_y = -ball->vel_y;
     
     // Accelerate ball slightly (1% speed increase per bounce)
@@ -86,19 +94,16 @@ void ball_bounce_y(Ball* ball, TextureManager* tm) {
     if (fabs(ball->vel_y) > max_speed) {
         ball->vel_y = ball->vel_y > 0 ? max_speed : -max_speed;
     }
-    
-    play_sfx(tm->sfx_ball_wall);
 }
 
-void ball_reset(Ball* ball, float x, float y) {
+void ball_reset(Ball* ball, float x, float y, float angle_degrees) {
     ball->x = x;
     ball->y = y;
+    ball->prev_x = x;
+    ball->prev_y = y;
     
-    // Always go upward, but randomize the horizontal direction and angle
+    // Always go upward, at the angle the caller picked
     ball->vel_y = -200.0f; // Always upward
-    
-    // Random angle between -60 to +60 degrees (converted to radians)
-    float angle_degrees = -60.0f + (rand() % 121); // -60 to +60
     float angle_radians = angle_degrees * M_PI / 180.0f;
     
     // Calculate X velocity based on angle, maintaining roughly same speed
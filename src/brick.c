@@ -1,37 +1,171 @@
 #include "brick.h"
+#include "log.h"
 #include "game.h"
+#include "trace.h"
 #include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
 #include <math.h>
 
-void brick_init(Brick* brick, float x, float y, BrickType type, SDL_Texture* texture) {
-    brick->x = x;
-    brick->y = y;
-    brick->width = 50;
-    brick->height = 20;
-    brick->type = type;
-    brick->destroyed = false;
-    brick->texture = texture;
-}
+#define LIVE_WORD_BITS 64
+
+// Walks the bricks filed under the cells overlapping a box
+typedef struct {
+    BrickGrid* grid;
+    int col_min, col_max, row_max;
+    int col, row;
+    int pos, end;
+    Uint64 bits;          // Remaining live bits when scanning without an index
+} BrickQuery;
 
-void brick_render(Brick* brick, SDL_Renderer* renderer) {
-    if (!brick->destroyed && brick->texture) {
-        SDL_Rect dest_rect = {
-            (int)brick->x, (int)brick->y,
-            brick->width, brick->height
-        };
-        SDL_RenderCopy(renderer, brick->texture, NULL, &dest_rect);
+static int lowest_set_bit(Uint64 bits) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(bits);
+#else
+    int bit = 0;
+    while (!(bits & 1)) {
+        bits >>= 1;
+        bit++;
     }
+    return bit;
+#endif
 }
 
-void brick_grid_init(BrickGrid* grid, SDL_Texture* textures[BRICK_TYPES_COUNT]) {
+static int live_word_count(int count) {
+    return (count + LIVE_WORD_BITS - 1) / LIVE_WORD_BITS;
+}
+
+void brick_grid_init(BrickGrid* grid, const Texture* const textures[BRICK_TYPES_COUNT]) {
+    grid->block = NULL;
+    grid->x = NULL;
+    grid->y = NULL;
+    grid->width = NULL;
+    grid->height = NULL;
+    grid->type = NULL;
+    grid->live = NULL;
     grid->count = 0;
+    grid->capacity = 0;
+    grid->live_count = 0;
+    grid->on_event = NULL;
+    grid->event_user_data = NULL;
+    grid->layer = NULL;
+    grid->layer_dirty = true;
+    grid->layer_unsupported = false;
+    grid->layer_erase_count = 0;
     for (int i = 0; i < BRICK_TYPES_COUNT; i++) {
-        grid->textures[i] = textures[i];
+        grid->textures[i] = textures ? textures[i] : NULL;
     }
+    memset(&grid->index, 0, sizeof(grid->index));
 }
 
-void brick_grid_create_stage(BrickGrid* grid, int stage) {
+void brick_grid_cleanup(BrickGrid* grid) {
+    free(grid->block);
+    grid->block = NULL;
+    grid->x = NULL;
+    grid->y = NULL;
+    grid->width = NULL;
+    grid->height = NULL;
+    grid->type = NULL;
+    grid->live = NULL;
+    grid->capacity = 0;
+    grid->live_count = 0;
+    if (grid->layer) {
+        SDL_DestroyTexture(grid->layer);
+        grid->layer = NULL;
+    }
+    free(grid->index.cell_start);
+    free(grid->index.cell_bricks);
+    memset(&grid->index, 0, sizeof(grid->index));
     grid->count = 0;
+}
+
+void brick_grid_set_event_callback(BrickGrid* grid, BrickEventCallback callback, void* user_data) {
+    grid->on_event = callback;
+    grid->event_user_data = user_data;
+}
+
+bool brick_grid_reserve(BrickGrid* grid, int capacity) {
+    if (capacity <= grid->capacity) return true;
+    
+    // Capacity stays a multiple of the bitset word size
+    int new_capacity = grid->capacity > 0 ? grid->capacity : LIVE_WORD_BITS;
+    while (new_capacity < capacity) {
+        new_capacity *= 2;
+    }
+    
+    // One block: live words first, then the float arrays, then the types
+    size_t words = (size_t)new_capacity / LIVE_WORD_BITS;
+    size_t size = words * sizeof(Uint64) + 4 * (size_t)new_capacity * sizeof(float) +
+                  (size_t)new_capacity * sizeof(Uint8);
+    char* block = malloc(size);
+    if (!block) {
+        LOG_WARN(LOG_GAMEPLAY, "Failed to grow brick storage to %d bricks", new_capacity);
+        return false;
+    }
+    
+    Uint64* live = (Uint64*)block;
+    float* x = (float*)(live + words);
+    float* y = x + new_capacity;
+    float* width = y + new_capacity;
+    float* height = width + new_capacity;
+    Uint8* type = (Uint8*)(height + new_capacity);
+    
+    memset(live, 0, words * sizeof(Uint64));
+    if (grid->count > 0) {
+        memcpy(live, grid->live, live_word_count(grid->count) * sizeof(Uint64));
+        memcpy(x, grid->x, grid->count * sizeof(float));
+        memcpy(y, grid->y, grid->count * sizeof(float));
+        memcpy(width, grid->width, grid->count * sizeof(float));
+        memcpy(height, grid->height, grid->count * sizeof(float));
+        memcpy(type, grid->type, grid->count * sizeof(Uint8));
+    }
+    
+    free(grid->block);
+    grid->block = block;
+    grid->live = live;
+    grid->x = x;
+    grid->y = y;
+    grid->width = width;
+    grid->height = height;
+    grid->type = type;
+    grid->capacity = new_capacity;
+    return true;
+}
+
+int brick_grid_add(BrickGrid* grid, float x, float y, int width, int height, BrickType type) {
+    if (grid->count == grid->capacity && !brick_grid_reserve(grid, grid->count + 1)) {
+        return -1;
+    }
+    
+    int i = grid->count++;
+    grid->x[i] = x;
+    grid->y[i] = y;
+    grid->width[i] = (float)width;
+    grid->height[i] = (float)height;
+    grid->type[i] = (Uint8)type;
+    grid->live[i / LIVE_WORD_BITS] |= (Uint64)1 << (i % LIVE_WORD_BITS);
+    grid->live_count++;
+    return i;
+}
+
+bool brick_grid_is_live(BrickGrid* grid, int index) {
+    if (index < 0 || index >= grid->count) return false;
+    return (grid->live[index / LIVE_WORD_BITS] >> (index % LIVE_WORD_BITS)) & 1;
+}
+
+// Clear the bitset for a new layout
+void brick_grid_clear(BrickGrid* grid) {
+    if (grid->live) {
+        memset(grid->live, 0, live_word_count(grid->count) * sizeof(Uint64));
+    }
+    grid->count = 0;
+    grid->live_count = 0;
+    grid->layer_dirty = true;
+    brick_grid_drop_index(grid);
+}
+
+void brick_grid_create_stage(BrickGrid* grid, int stage) {
+    brick_grid_clear(grid);
     
     int header_height = 60; // Reserve space for UI header
     int margin = 5;         // Equal margin on both sides
@@ -52,15 +186,11 @@ void brick_grid_create_stage(BrickGrid* grid, int stage) {
         int rows = 5;
         for (int row = 0; row < rows; row++) {
             for (int col = 0; col < cols; col++) {
-                if (grid->count < MAX_BRICKS) {
-                    float x = start_x + col * brick_width;
-                    float y = start_y + row * brick_height;
-                    BrickType type = row_types[row % BRICK_TYPES_COUNT];
-                    
-                    brick_init(&grid->bricks[grid->count], x, y, type, grid->textures[type]);
-                    grid->bricks[grid->count].width = brick_width - 2; // Small gap between bricks
-                    grid->count++;
-                }
+                float x = start_x + col * brick_width;
+                float y = start_y + row * brick_height;
+                BrickType type = row_types[row % BRICK_TYPES_COUNT];
+                
+                brick_grid_add(grid, x, y, brick_width - 2, 20, type); // Small gap between bricks
             }
         }
     } else if (stage == 2) {
@@ -68,14 +198,12 @@ void brick_grid_create_stage(BrickGrid* grid, int stage) {
         int rows = 6;
         for (int row = 0; row < rows; row++) {
             for (int col = 0; col < cols; col++) {
-                if ((row + col) % 2 == 0 && grid->count < MAX_BRICKS) {
+                if ((row + col) % 2 == 0) {
                     float x = start_x + col * brick_width;
                     float y = start_y + row * brick_height;
                     BrickType type = row_types[(row/2) % BRICK_TYPES_COUNT];
                     
-                    brick_init(&grid->bricks[grid->count], x, y, type, grid->textures[type]);
-                    grid->bricks[grid->count].width = brick_width - 2;
-                    grid->count++;
+                    brick_grid_add(grid, x, y, brick_width - 2, 20, type);
                 }
             }
         }
@@ -88,14 +216,12 @@ void brick_grid_create_stage(BrickGrid* grid, int stage) {
                 int distance_from_center = abs(col - center);
                 int max_distance_for_row = (row < rows/2) ? row + 1 : rows - row;
                 
-                if (distance_from_center < max_distance_for_row && grid->count < MAX_BRICKS) {
+                if (distance_from_center < max_distance_for_row) {
                     float x = start_x + col * brick_width;
                     float y = start_y + row * brick_height;
                     BrickType type = row_types[distance_from_center % BRICK_TYPES_COUNT];
                     
-                    brick_init(&grid->bricks[grid->count], x, y, type, grid->textures[type]);
-                    grid->bricks[grid->count].width = brick_width - 2;
-                    grid->count++;
+                    brick_grid_add(grid, x, y, brick_width - 2, 20, type);
                 }
             }
         }
@@ -115,14 +241,12 @@ void brick_grid_create_stage(BrickGrid* grid, int stage) {
                     place_brick = true; // More internal structure
                 }
                 
-                if (place_brick && grid->count < MAX_BRICKS) {
+                if (place_brick) {
                     float x = start_x + col * brick_width;
                     float y = start_y + row * brick_height;
                     BrickType type = row_types[row % BRICK_TYPES_COUNT];
                     
-                    brick_init(&grid->bricks[grid->count], x, y, type, grid->textures[type]);
-                    grid->bricks[grid->count].width = brick_width - 2;
-                    grid->count++;
+                    brick_grid_add(grid, x, y, brick_width - 2, 20, type);
                 }
             }
         }
@@ -142,49 +266,452 @@ void brick_grid_create_stage(BrickGrid* grid, int stage) {
                     place_brick = (col % 4 == 1 || col % 4 == 3);
                 }
                 
-                if (place_brick && grid->count < MAX_BRICKS) {
+                if (place_brick) {
                     float x = start_x + col * brick_width;
                     float y = start_y + row * brick_height;
                     BrickType type = row_types[col % BRICK_TYPES_COUNT];
                     
-                    brick_init(&grid->bricks[grid->count], x, y, type, grid->textures[type]);
-                    grid->bricks[grid->count].width = brick_width - 2;
-                    grid->count++;
+                    brick_grid_add(grid, x, y, brick_width - 2, 20, type);
                 }
             }
         }
     }
+    
+    brick_grid_build_index(grid);
+}
+
+void brick_grid_create_wall(BrickGrid* grid, int cols, int rows) {
+    brick_grid_clear(grid);
+    
+    if (cols > 0 && rows > 0 && brick_grid_reserve(grid, cols * rows)) {
+        int margin = 5;
+        int start_y = 60 + 20;                       // Below header with small margin
+        int field_height = (WINDOW_HEIGHT - start_y) * 2 / 3; // Leave room above the paddle
+        int brick_width = (WINDOW_WIDTH - (2 * margin)) / cols;
+        int brick_height = field_height / rows;
+        int start_x = (WINDOW_WIDTH - brick_width * cols) / 2;
+        
+        // Keep a gap between bricks while they're big enough to show one
+        int gap_x = brick_width > 4 ? 2 : 0;
+        int gap_y = brick_height > 4 ? 2 : 0;
+        if (brick_width < 1) brick_width = 1;
+        if (brick_height < 1) brick_height = 1;
+        
+        for (int row = 0; row < rows; row++) {
+            for (int col = 0; col < cols; col++) {
+                float x = start_x + col * brick_width;
+                float y = start_y + row * brick_height;
+                BrickType type = (BrickType)(row % BRICK_TYPES_COUNT);
+                
+                brick_grid_add(grid, x, y, brick_width - gap_x, brick_height - gap_y, type);
+            }
+        }
+    }
+    
+    brick_grid_build_index(grid);
+}
+
+// Cell range covered by a box, clamped to the grid; false if it misses the grid
+static bool brick_index_range(const BrickIndex* index, float x0, float y0, float x1, float y1,
+                              int* col_min, int* row_min, int* col_max, int* row_max) {
+    float grid_right = index->origin_x + index->cols * index->cell_width;
+    float grid_bottom = index->origin_y + index->rows * index->cell_height;
+    if (x1 < index->origin_x || y1 < index->origin_y || x0 > grid_right || y0 > grid_bottom) {
+        return false;
+    }
+    
+    *col_min = (int)floorf((x0 - index->origin_x) / index->cell_width);
+    *row_min = (int)floorf((y0 - index->origin_y) / index->cell_height);
+    *col_max = (int)floorf((x1 - index->origin_x) / index->cell_width);
+    *row_max = (int)floorf((y1 - index->origin_y) / index->cell_height);
+    
+    if (*col_min < 0) *col_min = 0;
+    if (*row_min < 0) *row_min = 0;
+    if (*col_min >= index->cols) *col_min = index->cols - 1;
+    if (*row_min >= index->rows) *row_min = index->rows - 1;
+    if (*col_max >= index->cols) *col_max = index->cols - 1;
+    if (*row_max >= index->rows) *row_max = index->rows - 1;
+    return true;
+}
+
+void brick_grid_drop_index(BrickGrid* grid) {
+    grid->index.cols = 0;
+    grid->index.rows = 0;
 }
 
-void brick_grid_render(BrickGrid* grid, SDL_Renderer* renderer) {
+void brick_grid_build_index(BrickGrid* grid) {
+    BrickIndex* index = &grid->index;
+    index->cols = 0;
+    index->rows = 0;
+    if (grid->count == 0) return;
+    
+    // Cells are sized to the smallest brick so each brick covers few cells
+    float min_x = grid->x[0];
+    float min_y = grid->y[0];
+    float max_x = min_x;
+    float max_y = min_y;
+    float cell_width = grid->width[0];
+    float cell_height = grid->height[0];
     for (int i = 0; i < grid->count; i++) {
-        brick_render(&grid->bricks[i], renderer);
+        min_x = fminf(min_x, grid->x[i]);
+        min_y = fminf(min_y, grid->y[i]);
+        max_x = fmaxf(max_x, grid->x[i] + grid->width[i]);
+        max_y = fmaxf(max_y, grid->y[i] + grid->height[i]);
+        cell_width = fminf(cell_width, grid->width[i]);
+        cell_height = fminf(cell_height, grid->height[i]);
+    }
+    if (cell_width < 1.0f) cell_width = 1.0f;
+    if (cell_height < 1.0f) cell_height = 1.0f;
+    
+    int cols = (int)ceilf((max_x - min_x) / cell_width);
+    int rows = (int)ceilf((max_y - min_y) / cell_height);
+    if (cols < 1) cols = 1;
+    if (rows < 1) rows = 1;
+    int cells = cols * rows;
+    
+    index->origin_x = min_x;
+    index->origin_y = min_y;
+    index->cell_width = cell_width;
+    index->cell_height = cell_height;
+    index->cols = cols;
+    index->rows = rows;
+    
+    // Storage is kept between stages and only grows
+    if (cells + 1 > index->cell_capacity) {
+        int* cell_start = realloc(index->cell_start, (cells + 1) * sizeof(int));
+        if (!cell_start) {
+            LOG_WARN(LOG_GAMEPLAY, "Failed to allocate brick index, using linear scans");
+            index->cols = 0;
+            index->rows = 0;
+            return;
+        }
+        index->cell_start = cell_start;
+        index->cell_capacity = cells + 1;
+    }
+    
+    // Count the bricks per cell, then turn the counts into offsets
+    memset(index->cell_start, 0, (cells + 1) * sizeof(int));
+    for (int i = 0; i < grid->count; i++) {
+        int c0, r0, c1, r1;
+        brick_index_range(index, grid->x[i], grid->y[i], grid->x[i] + grid->width[i], grid->y[i] + grid->height[i],
+                          &c0, &r0, &c1, &r1);
+        for (int row = r0; row <= r1; row++) {
+            for (int col = c0; col <= c1; col++) {
+                index->cell_start[row * cols + col]++;
+            }
+        }
+    }
+    
+    int total = 0;
+    for (int c = 0; c < cells; c++) {
+        int count = index->cell_start[c];
+        index->cell_start[c] = total;
+        total += count;
+    }
+    index->cell_start[cells] = total;
+    
+    if (total > index->entry_capacity) {
+        int* cell_bricks = realloc(index->cell_bricks, total * sizeof(int));
+        if (!cell_bricks) {
+            LOG_WARN(LOG_GAMEPLAY, "Failed to allocate brick index, using linear scans");
+            index->cols = 0;
+            index->rows = 0;
+            return;
+        }
+        index->cell_bricks = cell_bricks;
+        index->entry_capacity = total;
+    }
+    
+    // File each brick under its cells in index order; cell_start[c] is used
+    // as the write cursor and shifted back afterwards
+    for (int i = 0; i < grid->count; i++) {
+        int c0, r0, c1, r1;
+        brick_index_range(index, grid->x[i], grid->y[i], grid->x[i] + grid->width[i], grid->y[i] + grid->height[i],
+                          &c0, &r0, &c1, &r1);
+        for (int row = r0; row <= r1; row++) {
+            for (int col = c0; col <= c1; col++) {
+                index->cell_bricks[index->cell_start[row * cols + col]++] = i;
+            }
+        }
+    }
+    for (int c = cells; c > 0; c--) {
+        index->cell_start[c] = index->cell_start[c - 1];
+    }
+    index->cell_start[0] = 0;
+}
+
+static void brick_query_begin(BrickQuery* query, BrickGrid* grid, float x0, float y0, float x1, float y1) {
+    BrickIndex* index = &grid->index;
+    query->grid = grid;
+    query->pos = 0;
+    
+    // No index: fall back to walking the live bitset
+    if (index->cols == 0) {
+        query->col_min = -1;
+        query->end = live_word_count(grid->count);
+        query->bits = query->end > 0 ? grid->live[0] : 0;
+        return;
+    }
+    
+    int row_min;
+    if (!brick_index_range(index, x0, y0, x1, y1, &query->col_min, &row_min, &query->col_max, &query->row_max)) {
+        query->col_min = 0;
+        query->col_max = -1;
+        query->row_max = -1;
+        query->col = 0;
+        query->row = 0;
+        query->end = 0;
+        return;
+    }
+    
+    query->col = query->col_min;
+    query->row = row_min;
+    int cell = query->row * index->cols + query->col;
+    query->pos = index->cell_start[cell];
+    query->end = index->cell_start[cell + 1];
+}
+
+static int brick_query_next(BrickQuery* query) {
+    BrickIndex* index = &query->grid->index;
+    
+    if (query->col_min < 0) {
+        while (!query->bits) {
+            if (++query->pos >= query->end) return -1;
+            query->bits = query->grid->live[query->pos];
+        }
+        int bit = lowest_set_bit(query->bits);
+        query->bits &= query->bits - 1;
+        return query->pos * LIVE_WORD_BITS + bit;
+    }
+    
+    while (query->pos >= query->end) {
+        if (++query->col > query->col_max) {
+            query->col = query->col_min;
+            if (++query->row > query->row_max) {
+                return -1;
+            }
+        }
+        int cell = query->row * index->cols + query->col;
+        query->pos = index->cell_start[cell];
+        query->end = index->cell_start[cell + 1];
+    }
+    
+    return index->cell_bricks[query->pos++];
+}
+
+static void brick_grid_draw_bricks(BrickGrid* grid, SpriteBatch* batch) {
+    SDL_Color white = {255, 255, 255, 255};
+    int words = live_word_count(grid->count);
+    for (int w = 0; w < words; w++) {
+        for (Uint64 bits = grid->live[w]; bits; bits &= bits - 1) {
+            int i = w * LIVE_WORD_BITS + lowest_set_bit(bits);
+            const Texture* texture = grid->textures[grid->type[i]];
+            if (texture && texture->texture) {
+                sprite_batch_draw(batch, texture->texture, &texture->src, (int)grid->x[i], (int)grid->y[i],
+                                  (int)grid->width[i], (int)grid->height[i], white);
+            }
+        }
+    }
+}
+
+void brick_grid_invalidate_layer(BrickGrid* grid, bool textures_lost) {
+    // A lost device takes the texture with it; otherwise only its contents
+    if (textures_lost && grid->layer) {
+        SDL_DestroyTexture(grid->layer);
+        grid->layer = NULL;
+    }
+    grid->layer_dirty = true;
+}
+
+static bool brick_grid_update_layer(BrickGrid* grid, SpriteBatch* batch) {
+    SDL_Renderer* renderer = batch->renderer;
+    if (!grid->layer) {
+        if (grid->layer_unsupported) return false;
+        
+        if (SDL_RenderTargetSupported(renderer)) {
+            grid->layer = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                            WINDOW_WIDTH, WINDOW_HEIGHT);
+        }
+        if (!grid->layer) {
+            LOG_WARN(LOG_RENDER, "Brick layer unavailable, drawing bricks individually: %s", SDL_GetError());
+            grid->layer_unsupported = true;
+            return false;
+        }
+        SDL_SetTextureBlendMode(grid->layer, SDL_BLENDMODE_BLEND);
+        grid->layer_dirty = true;
+    }
+    
+    if (!grid->layer_dirty && grid->layer_erase_count == 0) {
+        return true;
+    }
+    
+    // Sprites already queued belong to the previous target
+    sprite_batch_flush(batch);
+    
+    SDL_Texture* previous_target = SDL_GetRenderTarget(renderer);
+    SDL_BlendMode previous_blend;
+    Uint8 r, g, b, a;
+    SDL_GetRenderDrawBlendMode(renderer, &previous_blend);
+    SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+    
+    SDL_SetRenderTarget(renderer, grid->layer);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    
+    if (grid->layer_dirty) {
+        SDL_RenderClear(renderer);
+        
+        // Copy brick pixels straight in so alpha isn't applied twice when
+        // the layer itself is blended onto the frame
+        SDL_BlendMode texture_blend[BRICK_TYPES_COUNT];
+        for (int i = 0; i < BRICK_TYPES_COUNT; i++) {
+            if (grid->textures[i] && grid->textures[i]->texture) {
+                SDL_GetTextureBlendMode(grid->textures[i]->texture, &texture_blend[i]);
+                SDL_SetTextureBlendMode(grid->textures[i]->texture, SDL_BLENDMODE_NONE);
+            }
+        }
+        brick_grid_draw_bricks(grid, batch);
+        sprite_batch_flush(batch);
+        // Reverse order so a texture shared by several types, such as the
+        // sprite page, gets its original mode back
+        for (int i = BRICK_TYPES_COUNT - 1; i >= 0; i--) {
+            if (grid->textures[i] && grid->textures[i]->texture) {
+                SDL_SetTextureBlendMode(grid->textures[i]->texture, texture_blend[i]);
+            }
+        }
+    } else {
+        // Punch fully transparent holes where bricks were destroyed
+        SDL_RenderFillRects(renderer, grid->layer_erases, grid->layer_erase_count);
+    }
+    grid->layer_dirty = false;
+    grid->layer_erase_count = 0;
+    
+    SDL_SetRenderTarget(renderer, previous_target);
+    SDL_SetRenderDrawBlendMode(renderer, previous_blend);
+    SDL_SetRenderDrawColor(renderer, r, g, b, a);
+    return true;
+}
+
+void brick_grid_render(BrickGrid* grid, SpriteBatch* batch) {
+    TRACE_SCOPE("brick_grid_render");
+    if (brick_grid_update_layer(grid, batch)) {
+        SDL_Color white = {255, 255, 255, 255};
+        sprite_batch_draw(batch, grid->layer, NULL, 0, 0, WINDOW_WIDTH, WINDOW_HEIGHT, white);
+    } else {
+        brick_grid_draw_bricks(grid, batch);
     }
 }
 
 bool brick_grid_check_collision(BrickGrid* grid, float ball_x, float ball_y, float ball_w, float ball_h) {
-    for (int i = 0; i < grid->count; i++) {
-        Brick* brick = &grid->bricks[i];
-        if (brick->destroyed) continue;
+    BrickHit hit;
+    if (!brick_grid_sweep(grid, ball_x, ball_y, ball_w, ball_h, 0.0f, 0.0f, &hit)) {
+        return false;
+    }
+    brick_grid_destroy_brick(grid, hit.index);
+    return true;
+}
+
+bool brick_grid_all_destroyed(BrickGrid* grid) {
+    // One test per 64 bricks, straight from the bitset rather than live_count
+    int words = live_word_count(grid->count);
+    for (int w = 0; w < words; w++) {
+        if (grid->live[w]) return false;
+    }
+    return true;
+}
+
+// Time interval during which a moving point is inside the slab [min, max]
+static bool sweep_axis(float start, float move, float min, float max, float* entry, float* exit) {
+    if (move == 0.0f) {
+        if (start <= min || start >= max) {
+            return false;
+        }
+        *entry = -INFINITY;
+        *exit = INFINITY;
+        return true;
+    }
+    
+    float t1 = (min - start) / move;
+    float t2 = (max - start) / move;
+    *entry = fminf(t1, t2);
+    *exit = fmaxf(t1, t2);
+    return true;
+}
+
+bool brick_grid_sweep(BrickGrid* grid, float ball_x, float ball_y, float ball_w, float ball_h,
+                      float move_x, float move_y, BrickHit* hit) {
+    bool found = false;
+    hit->index = -1;
+    hit->time = INFINITY;
+    
+    // Only bricks in the cells under the swept bounds can be hit
+    BrickQuery query;
+    brick_query_begin(&query, grid,
+                      fminf(ball_x, ball_x + move_x), fminf(ball_y, ball_y + move_y),
+                      fmaxf(ball_x, ball_x + move_x) + ball_w, fmaxf(ball_y, ball_y + move_y) + ball_h);
+    
+    int i;
+    while ((i = brick_query_next(&query)) >= 0) {
+        if (!brick_grid_is_live(grid, i)) continue;
+        
+        // Sweep the ball's corner against the brick grown by the ball size
+        float entry_x, exit_x, entry_y, exit_y;
+        if (!sweep_axis(ball_x, move_x, grid->x[i] - ball_w, grid->x[i] + grid->width[i], &entry_x, &exit_x) ||
+            !sweep_axis(ball_y, move_y, grid->y[i] - ball_h, grid->y[i] + grid->height[i], &entry_y, &exit_y)) {
+            continue;
+        }
+        
+        float entry = fmaxf(entry_x, entry_y);
+        float exit = fminf(exit_x, exit_y);
+        if (entry >= exit || entry >= 1.0f || exit <= 0.0f) {
+            continue;
+        }
         
-        // Simple AABB collision detection
-        if (ball_x < brick->x + brick->width &&
-            ball_x + ball_w > brick->x &&
-            ball_y < brick->y + brick->height &&
-            ball_y + ball_h > brick->y) {
+        // Earliest contact wins; ties go to the lower index
+        float time = fmaxf(entry, 0.0f);
+        if (time < hit->time || (time == hit->time && i < hit->index)) {
+            found = true;
+            hit->index = i;
+            hit->time = time;
+            hit->normal_x = 0.0f;
+            hit->normal_y = 0.0f;
             
-            brick->destroyed = true;
-            return true; // Collision detected
+            // The axis entered last is the face that was struck
+            if (entry_x >= entry_y && move_x != 0.0f) {
+                hit->normal_x = move_x > 0.0f ? -1.0f : 1.0f;
+            }
+            if (entry_y >= entry_x && move_y != 0.0f) {
+                hit->normal_y = move_y > 0.0f ? -1.0f : 1.0f;
+            }
         }
     }
-    return false;
+    
+    return found;
 }
 
-bool brick_grid_all_destroyed(BrickGrid* grid) {
-    for (int i = 0; i < grid->count; i++) {
-        if (!grid->bricks[i].destroyed) {
-            return false; // Found a brick that's not destroyed
+void brick_grid_destroy_brick(BrickGrid* grid, int index) {
+    if (!brick_grid_is_live(grid, index)) return;
+    
+    grid->live[index / LIVE_WORD_BITS] &= ~((Uint64)1 << (index % LIVE_WORD_BITS));
+    grid->live_count--;
+    
+    // Erase just this brick from the layer, or redraw it all if too many queue up
+    if (!grid->layer_dirty) {
+        if (grid->layer_erase_count < BRICK_LAYER_MAX_ERASES) {
+            SDL_Rect* rect = &grid->layer_erases[grid->layer_erase_count++];
+            rect->x = (int)grid->x[index];
+            rect->y = (int)grid->y[index];
+            rect->w = (int)grid->width[index];
+            rect->h = (int)grid->height[index];
+        } else {
+            grid->layer_dirty = true;
         }
     }
-    return true; // All bricks destroyed
-}
\ No newline at end of file
+    
+    if (grid->on_event) {
+        grid->on_event(BRICK_EVENT_DESTROYED, index, grid->event_user_data);
+        if (grid->live_count == 0) {
+            grid->on_event(BRICK_EVENT_STAGE_CLEARED, index, grid->event_user_data);
+        }
+    }
+}
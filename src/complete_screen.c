@@ -3,15 +3,27 @@
 #include <stdio.h>
 
 void complete_screen_init(CompleteScreen* cs, TextureManager* tm, int score) {
-    printf("DEBUG: complete_screen_init called with score: %d\n", score);
     cs->current_option = COMPLETE_PLAY_AGAIN;
     cs->texture_manager = tm;
     cs->final_score = score;
     
-    // Start game complete BGM
-    play_bgm(tm->bgm_complete);
+    cs->background = asset_acquire(&tm->assets, "background");
+    cs->kion_happi = asset_acquire(&tm->assets, "kion_happi");
+    cs->arrow = asset_acquire(&tm->assets, "arrow");
+    cs->menu_select = asset_acquire(&tm->assets, "sfx_menu_select");
+    cs->bgm = asset_acquire(&tm->assets, "bgm_complete");
     
-    printf("DEBUG: complete_screen_init completed\n");
+    // Start game complete BGM
+    asset_play_music(&tm->assets, cs->bgm);
+}
+
+void complete_screen_cleanup(CompleteScreen* cs) {
+    AssetRegistry* assets = &cs->texture_manager->assets;
+    asset_release(assets, cs->background);
+    asset_release(assets, cs->kion_happi);
+    asset_release(assets, cs->arrow);
+    asset_release(assets, cs->menu_select);
+    asset_release(assets, cs->bgm);
 }
 
 void complete_screen_handle_input(CompleteScreen* cs, SDL_Event* e, int* next_state) {
@@ -19,15 +31,15 @@ void complete_screen_handle_input(CompleteScreen* cs, SDL_Event* e, int* next_st
         switch (e->key.keysym.sym) {
             case SDLK_UP:
                 cs->current_option = (cs->current_option - 1 + COMPLETE_MENU_COUNT) % COMPLETE_MENU_COUNT;
-                play_sfx(cs->texture_manager->sfx_menu_select);
+                asset_play_sound(&cs->texture_manager->assets, cs->menu_select);
                 break;
             case SDLK_DOWN:
                 cs->current_option = (cs->current_option + 1) % COMPLETE_MENU_COUNT;
-                play_sfx(cs->texture_manager->sfx_menu_select);
+                asset_play_sound(&cs->texture_manager->assets, cs->menu_select);
                 break;
             case SDLK_RETURN:
             case SDLK_SPACE:
-                play_sfx(cs->texture_manager->sfx_menu_select);
+                asset_play_sound(&cs->texture_manager->assets, cs->menu_select);
                 if (cs->current_option == COMPLETE_PLAY_AGAIN) {
                     *next_state = GAME_STATE_TITLE;
                 } else if (cs->current_option == COMPLETE_QUIT) {
@@ -48,14 +60,15 @@ void complete_screen_update(CompleteScreen* cs, float delta_time) {
 }
 
 void complete_screen_render(CompleteScreen* cs, SDL_Renderer* renderer) {
-    printf("DEBUG: complete_screen_render started\n");
+    AssetRegistry* assets = &cs->texture_manager->assets;
+    const Texture* background = asset_texture(assets, cs->background);
+    const Texture* kion_happi = asset_texture(assets, cs->kion_happi);
+    const Texture* arrow = asset_texture(assets, cs->arrow);
     
     // Render background (bright)
-    if (cs->texture_manager->background.texture) {
-        printf("DEBUG: Rendering background\n");
-        render_texture(renderer, cs->texture_manager->background.texture, 
+    if (background->texture) {
+        render_texture(renderer, background->texture, 
                       0, 0, WINDOW_WIDTH, WINDOW_HEIGHT);
-        printf("DEBUG: Background rendered\n");
     }
     
     // Render bright overlay
@@ -66,13 +79,13 @@ void complete_screen_render(CompleteScreen* cs, SDL_Renderer* renderer) {
     SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
     
     // Render Kion happy character - match Kion-ded positioning
-    if (cs->texture_manager->kion_happi.texture) {
+    if (kion_happi->texture) {
         int kion_scale = 1; // Same scale as Kion-ded
-        int kion_width = cs->texture_manager->kion_happi.width * kion_scale;
-        int kion_height = cs->texture_manager->kion_happi.height * kion_scale;
+        int kion_width = kion_happi->width * kion_scale;
+        int kion_height = kion_happi->height * kion_scale;
         int kion_x = 20; // Same position as Kion-ded
         int kion_y = WINDOW_HEIGHT - kion_height; // Flush with bottom like Kion-ded
-        render_texture(renderer, cs->texture_manager->kion_happi.texture, 
+        render_texture(renderer, kion_happi->texture, 
                       kion_x, kion_y, kion_width, kion_height);
     }
     
@@ -82,14 +95,11 @@ void complete_screen_render(CompleteScreen* cs, SDL_Renderer* renderer) {
         
         char complete_text[] = "Complete!";
         int title_width, title_height;
-        SDL_Texture* title_texture = create_text_texture(renderer, cs->texture_manager->font_title, 
-                                                        complete_text, gold_color, &title_width, &title_height);
-        if (title_texture) {
-            int title_x = (WINDOW_WIDTH - title_width) / 2;
-            int title_y = 100;
-            render_texture(renderer, title_texture, title_x, title_y, title_width, title_height);
-            SDL_DestroyTexture(title_texture);
-        }
+        measure_text(cs->texture_manager, cs->texture_manager->font_title, 
+                     complete_text, &title_width, &title_height);
+        int title_x = (WINDOW_WIDTH - title_width) / 2;
+        draw_text(cs->texture_manager, cs->texture_manager->font_title, 
+                  complete_text, title_x, 100, gold_color);
     }
     
     // Render final score
@@ -99,25 +109,19 @@ void complete_screen_render(CompleteScreen* cs, SDL_Renderer* renderer) {
         char score_text[64];
         sprintf(score_text, "Final Score: %d", cs->final_score);
         int score_width, score_height;
-        SDL_Texture* score_texture = create_text_texture(renderer, cs->texture_manager->font_regular, 
-                                                        score_text, white_color, &score_width, &score_height);
-        if (score_texture) {
-            int score_x = (WINDOW_WIDTH - score_width) / 2;
-            int score_y = 180;
-            render_texture(renderer, score_texture, score_x, score_y, score_width, score_height);
-            SDL_DestroyTexture(score_texture);
-        }
+        measure_text(cs->texture_manager, cs->texture_manager->font_regular, 
+                     score_text, &score_width, &score_height);
+        int score_x = (WINDOW_WIDTH - score_width) / 2;
+        draw_text(cs->texture_manager, cs->texture_manager->font_regular, 
+                  score_text, score_x, 180, white_color);
         
         char congratulations[] = "All stages complete!";
         int congrats_width, congrats_height;
-        SDL_Texture* congrats_texture = create_text_texture(renderer, cs->texture_manager->font_regular, 
-                                                          congratulations, white_color, &congrats_width, &congrats_height);
-        if (congrats_texture) {
-            int congrats_x = (WINDOW_WIDTH - congrats_width) / 2;
-            int congrats_y = 220;
-            render_texture(renderer, congrats_texture, congrats_x, congrats_y, congrats_width, congrats_height);
-            SDL_DestroyTexture(congrats_texture);
-        }
+        measure_text(cs->texture_manager, cs->texture_manager->font_regular, 
+                     congratulations, &congrats_width, &congrats_height);
+        int congrats_x = (WINDOW_WIDTH - congrats_width) / 2;
+        draw_text(cs->texture_manager, cs->texture_manager->font_regular, 
+                  congratulations, congrats_x, 220, white_color);
     }
     
     // Render menu options
@@ -132,20 +136,18 @@ void complete_screen_render(CompleteScreen* cs, SDL_Renderer* renderer) {
             int text_width, text_height;
             SDL_Color text_color = (i == (int)cs->current_option) ? yellow_color : white_color;
             
-            SDL_Texture* text_texture = create_text_texture(renderer, cs->texture_manager->font_regular, 
-                                                           menu_items[i], text_color, &text_width, &text_height);
-            if (text_texture) {
-                int text_x = menu_x;
-                int text_y = menu_y + i * 50;
-                render_texture(renderer, text_texture, text_x, text_y, text_width, text_height);
-                SDL_DestroyTexture(text_texture);
-                
-                if (i == (int)cs->current_option && cs->texture_manager->arrow.texture) {
-                    int arrow_x = menu_x - 40;
-                    int arrow_y = text_y + (text_height - cs->texture_manager->arrow.height) / 2;
-                    render_texture(renderer, cs->texture_manager->arrow.texture, 
-                                  arrow_x, arrow_y, cs->texture_manager->arrow.width, cs->texture_manager->arrow.height);
-                }
+            int text_x = menu_x;
+            int text_y = menu_y + i * 50;
+            measure_text(cs->texture_manager, cs->texture_manager->font_regular, 
+                         menu_items[i], &text_width, &text_height);
+            draw_text(cs->texture_manager, cs->texture_manager->font_regular, 
+                      menu_items[i], text_x, text_y, text_color);
+            
+            if (i == (int)cs->current_option && arrow->texture) {
+                int arrow_x = menu_x - 40;
+                int arrow_y = text_y + (text_height - arrow->height) / 2;
+                draw_sprite(cs->texture_manager, arrow,
+                            arrow_x, arrow_y, arrow->width, arrow->height);
             }
         }
     }
@@ -1,20 +1,31 @@
 #include "game.h"
+#include "log.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 
-int game_init(Game* game) {
-    printf("DEBUG: Starting SDL initialization...\n");
+int game_init(Game* game, const GameOptions* options) {
+    LOG_DEBUG(LOG_GAME, "Starting SDL initialization...");
+    TRACE_INIT();
+    TRACE_THREAD_NAME("main");
+    
+    game->options = *options;
+    memset(&game->replay, 0, sizeof(game->replay));
+    game->replay_tick = 0;
+    game->autoplay_wait = 0;
+    profiler_init(&game->profiler);
+    if (options->replay_path && !replay_load(&game->replay, options->replay_path)) {
+        return -1;
+    }
     
-    // Seed random number generator for random ball directions
-    srand(time(NULL));
     if (SDL_Init(SDL_INIT_VIDEO) < 0) {
-        printf("SDL could not initialize! SDL_Error: %s\n", SDL_GetError());
+        LOG_ERROR(LOG_GAME, "SDL could not initialize! SDL_Error: %s", SDL_GetError());
         return -1;
     }
-    printf("DEBUG: SDL initialized successfully\n");
+    LOG_DEBUG(LOG_GAME, "SDL initialized successfully");
     
-    printf("DEBUG: Creating window...\n");
+    LOG_DEBUG(LOG_GAME, "Creating window...");
     game->window = SDL_CreateWindow(
         WINDOW_TITLE,
         SDL_WINDOWPOS_UNDEFINED,
@@ -25,111 +36,281 @@ int game_init(Game* game) {
     );
     
     if (game->window == NULL) {
-        printf("Window could not be created! SDL_Error: %s\n", SDL_GetError());
+        LOG_ERROR(LOG_GAME, "Window could not be created! SDL_Error: %s", SDL_GetError());
         return -1;
     }
-    printf("DEBUG: Window created successfully\n");
+    LOG_DEBUG(LOG_GAME, "Window created successfully");
     
-    printf("DEBUG: Creating renderer...\n");
-    game->renderer = SDL_CreateRenderer(game->window, -1, SDL_RENDERER_ACCELERATED);
+    LOG_DEBUG(LOG_GAME, "Creating renderer...");
+    game->renderer = SDL_CreateRenderer(game->window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
     if (game->renderer == NULL) {
-        printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+        LOG_ERROR(LOG_GAME, "Renderer could not be created! SDL Error: %s", SDL_GetError());
         return -1;
     }
-    printf("DEBUG: Renderer created successfully\n");
     
-    printf("DEBUG: Initializing SDL_image...\n");
-    if (!(IMG_Init(IMG_INIT_PNG | IMG_INIT_JPG) & (IMG_INIT_PNG | IMG_INIT_JPG))) {
-        printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+    // Without vsync the loop paces itself with a sleep-until-deadline
+    SDL_RendererInfo renderer_info;
+    game->vsync = SDL_GetRendererInfo(game->renderer, &renderer_info) == 0 &&
+                  (renderer_info.flags & SDL_RENDERER_PRESENTVSYNC);
+    LOG_INFO(LOG_GAME, "Renderer created successfully (vsync %s)", game->vsync ? "on" : "off");
+    
+    LOG_DEBUG(LOG_GAME, "Initializing SDL_image...");
+    // Every format the manifest uses is set up here, before the asset
+    // workers start: SDL_image's lazy per-format init isn't thread-safe
+    int image_formats = IMG_Init(IMG_INIT_PNG | IMG_INIT_JPG | IMG_INIT_WEBP);
+    if (!(image_formats & (IMG_INIT_PNG | IMG_INIT_JPG))) {
+        LOG_ERROR(LOG_GAME, "SDL_image could not initialize! SDL_image Error: %s", IMG_GetError());
         return -1;
     }
-    printf("DEBUG: SDL_image initialized successfully\n");
+    if (!(image_formats & IMG_INIT_WEBP)) {
+        LOG_WARN(LOG_GAME, "No WebP support, WebP images won't load: %s", IMG_GetError());
+    }
+    LOG_DEBUG(LOG_GAME, "SDL_image initialized successfully");
     
-    printf("DEBUG: Initializing SDL_mixer...\n");
-    if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0) {
-        printf("Warning: SDL_mixer could not initialize! SDL_mixer Error: %s\n", Mix_GetError());
+    LOG_DEBUG(LOG_GAME, "Initializing SDL_mixer...");
+    if (!(Mix_Init(MIX_INIT_OGG) & MIX_INIT_OGG)) {
+        LOG_WARN(LOG_GAME, "No Ogg Vorbis support, BGM will play from WAV: %s", Mix_GetError());
+    }
+    // BRICKOUT_LOW_LATENCY_AUDIO=1 trades mixer headroom for quicker SFX
+    int audio_chunk_size = AUDIO_CHUNK_SIZE;
+    const char* low_latency = SDL_getenv("BRICKOUT_LOW_LATENCY_AUDIO");
+    if (low_latency && *low_latency && *low_latency != '0') {
+        audio_chunk_size = AUDIO_CHUNK_SIZE_LOW_LATENCY;
+    }
+    if (Mix_OpenAudio(AUDIO_FREQUENCY, AUDIO_FORMAT, AUDIO_CHANNELS, audio_chunk_size) < 0) {
+        LOG_WARN(LOG_GAME, "SDL_mixer could not initialize! SDL_mixer Error: %s", Mix_GetError());
         // Don't return error, continue without audio
     } else {
-        printf("DEBUG: SDL_mixer initialized successfully\n");
+        audio_init(audio_chunk_size);
+        LOG_DEBUG(LOG_GAME, "SDL_mixer initialized successfully");
     }
     
-    printf("DEBUG: Initializing SDL_ttf...\n");
+    LOG_DEBUG(LOG_GAME, "Initializing SDL_ttf...");
     if (TTF_Init() == -1) {
-        printf("SDL_ttf could not initialize! SDL_ttf Error: %s\n", TTF_GetError());
+        LOG_ERROR(LOG_GAME, "SDL_ttf could not initialize! SDL_ttf Error: %s", TTF_GetError());
         return -1;
     }
-    printf("DEBUG: SDL_ttf initialized successfully\n");
+    LOG_DEBUG(LOG_GAME, "SDL_ttf initialized successfully");
     
-    printf("DEBUG: Initializing texture manager...\n");
+    LOG_DEBUG(LOG_GAME, "Initializing texture manager...");
     if (texture_manager_init(&game->texture_manager, game->renderer) != 0) {
-        printf("Failed to initialize texture manager\n");
+        LOG_ERROR(LOG_GAME, "Failed to initialize texture manager");
         return -1;
     }
-    printf("DEBUG: Texture manager initialized successfully\n");
+    LOG_DEBUG(LOG_GAME, "Texture manager initialized successfully");
     
-    printf("DEBUG: Initializing title screen...\n");
+    LOG_DEBUG(LOG_GAME, "Initializing title screen...");
     title_screen_init(&game->title_screen, &game->texture_manager);
-    printf("DEBUG: Title screen initialized successfully\n");
+    LOG_DEBUG(LOG_GAME, "Title screen initialized successfully");
     
-    printf("DEBUG: Initializing gameplay...\n");
-    gameplay_init(&game->gameplay, &game->texture_manager);
-    printf("DEBUG: Gameplay initialized successfully\n");
+    // Acquired after the title screen so its assets load first
+    LOG_DEBUG(LOG_GAME, "Initializing gameplay...");
+    gameplay_init(&game->gameplay);
+    gameplay_view_init(&game->gameplay, &game->texture_manager);
+    LOG_DEBUG(LOG_GAME, "Gameplay initialized successfully");
     
     // Note: gameover_screen and complete_screen will be initialized when needed
     
     game->current_state = GAME_STATE_TITLE;
     game->running = true;
-    game->last_time = SDL_GetTicks();
-    game->delta_time = 0.0f;
+    game->last_counter = SDL_GetPerformanceCounter();
+    game->accumulator = 0;
+    game->delta_time = SIMULATION_STEP;
+    game->render_alpha = 0.0f;
     
     return 0;
 }
 
+static void game_start_gameplay(Game* game) {
+    // The brick layer is drawn once per stage, so the sprites must be in
+    gameplay_view_wait_sprites(&game->gameplay);
+    
+    // Each run gets its own seed so it can be recorded and replayed
+    Uint32 seed = (Uint32)time(NULL) ^ (Uint32)SDL_GetPerformanceCounter();
+    if (game->options.replay_path) {
+        seed = game->replay.seed;
+        game->replay_tick = 0;
+        LOG_INFO(LOG_REPLAY, "Replaying %s: %d ticks from seed %u", game->options.replay_path,
+                 game->replay.tick_count, (unsigned)seed);
+    } else if (game->options.record_path) {
+        replay_begin(&game->replay, seed);
+    }
+    gameplay_seed(&game->gameplay, seed);
+    gameplay_reset_game(&game->gameplay);
+}
+
+static void game_finish_run(Game* game) {
+    Uint32 hash = gameplay_state_hash(&game->gameplay);
+    if (game->options.replay_path) {
+        if (!game->running) return; // Already reported, or quit part way
+        
+        // A replay that ends anywhere else was recorded by a different simulation
+        bool matched = game->replay_tick == game->replay.tick_count && hash == game->replay.end_hash;
+        if (matched) {
+            LOG_INFO(LOG_REPLAY, "Replay matched after %d ticks (state %08x)",
+                     game->replay_tick, (unsigned)hash);
+        } else {
+            LOG_WARN(LOG_REPLAY, "Replay diverged after %d of %d ticks (state %08x, recorded %08x)",
+                     game->replay_tick, game->replay.tick_count,
+                     (unsigned)hash, (unsigned)game->replay.end_hash);
+        }
+        game->running = false;
+    } else if (game->options.record_path) {
+        replay_save(&game->replay, game->options.record_path, hash);
+    }
+}
+
+static void game_change_state(Game* game, int next_state) {
+    if (next_state == (int)game->current_state) return;
+    
+    // Screens shown only at the end of a run give back their assets
+    if (game->current_state == GAME_STATE_GAMEPLAY) {
+        game_finish_run(game);
+        gameplay_leave(&game->gameplay);
+    } else if (game->current_state == GAME_STATE_GAMEOVER) {
+        gameover_screen_cleanup(&game->gameover_screen);
+    } else if (game->current_state == GAME_STATE_COMPLETE) {
+        complete_screen_cleanup(&game->complete_screen);
+    }
+    game->current_state = next_state;
+    game->autoplay_wait = 0;
+    
+    // The outgoing screen's track was just freed, so pick the title's back up
+    if (next_state == GAME_STATE_TITLE) {
+        asset_play_music(&game->texture_manager.assets, game->title_screen.bgm);
+    }
+}
+
+static void game_autoplay_next_run(Game* game) {
+    // Leave the end screen up for a moment, then play again
+    if (++game->autoplay_wait < AUTOPLAY_END_SCREEN_TICKS) return;
+    game_start_gameplay(game);
+    game_change_state(game, GAME_STATE_GAMEPLAY);
+}
+
+static void game_wait_until(Uint64 deadline, Uint64 frequency) {
+    // Coarse sleep while the deadline is far off, then spin the last stretch
+    Uint64 spin_ticks = frequency / 500; // 2 ms
+    Uint64 now = SDL_GetPerformanceCounter();
+    while (now < deadline) {
+        Uint64 remaining = deadline - now;
+        if (remaining > spin_ticks) {
+            SDL_Delay((Uint32)((remaining - spin_ticks) * 1000 / frequency));
+        }
+        now = SDL_GetPerformanceCounter();
+    }
+}
+
 void game_run(Game* game) {
+    Uint64 frequency = SDL_GetPerformanceFrequency();
+    Uint64 step_ticks = frequency / SIMULATION_HZ;
+    Uint64 frame_ticks = frequency / TARGET_FPS;
+    Uint64 max_frame_ticks = (Uint64)(MAX_FRAME_TIME * frequency);
+    
+    game->last_counter = SDL_GetPerformanceCounter();
+    game->accumulator = 0;
+    Uint64 next_frame = game->last_counter + frame_ticks;
+    
+    // Replays skip the title screen and start from their own seed, as does autoplay
+    if (game->options.replay_path || game->options.autoplay) {
+        game_start_gameplay(game);
+        game_change_state(game, GAME_STATE_GAMEPLAY);
+    }
+    
     while (game->running) {
-        int current_time = SDL_GetTicks();
-        game->delta_time = (current_time - game->last_time) / 1000.0f;
-        game->last_time = current_time;
+        TRACE_SCOPE("frame");
+        profiler_begin_frame(&game->profiler);
+        Uint64 now = SDL_GetPerformanceCounter();
+        Uint64 frame_time = now - game->last_counter;
+        game->last_counter = now;
+        if (frame_time > max_frame_ticks) {
+            frame_time = max_frame_ticks;
+        }
+        game->accumulator += frame_time;
         
+        profiler_begin(&game->profiler, PROFILE_EVENTS);
+        asset_registry_update(&game->texture_manager.assets);
         game_handle_events(game);
-        game_update(game);
+        profiler_end(&game->profiler, PROFILE_EVENTS);
+        
+        // Advance the simulation in fixed steps
+        profiler_begin(&game->profiler, PROFILE_UPDATE);
+        game->delta_time = SIMULATION_STEP;
+        while (game->accumulator >= step_ticks && game->running) {
+            game_update(game);
+            game->accumulator -= step_ticks;
+        }
+        profiler_end(&game->profiler, PROFILE_UPDATE);
+        
+        profiler_begin(&game->profiler, PROFILE_RENDER);
+        game->render_alpha = (float)game->accumulator / (float)step_ticks;
         game_render(game);
+        profiler_end(&game->profiler, PROFILE_RENDER);
+        
+        profiler_begin(&game->profiler, PROFILE_PRESENT);
+        SDL_RenderPresent(game->renderer);
+        profiler_end(&game->profiler, PROFILE_PRESENT);
         
-        SDL_Delay(16);
+        if (!game->vsync) {
+            game_wait_until(next_frame, frequency);
+            next_frame += frame_ticks;
+            
+            // Fell more than a frame behind; don't try to make it up
+            now = SDL_GetPerformanceCounter();
+            if (now > next_frame) {
+                next_frame = now + frame_ticks;
+            }
+        }
     }
 }
 
 void game_cleanup(Game* game) {
-    printf("DEBUG: Starting cleanup...\n");
+    LOG_DEBUG(LOG_GAME, "Starting cleanup...");
+    
+    game_change_state(game, GAME_STATE_QUIT);
+    
+    LOG_DEBUG(LOG_GAME, "Cleaning up gameplay...");
+    gameplay_view_cleanup(&game->gameplay);
+    gameplay_cleanup(&game->gameplay);
+    title_screen_cleanup(&game->title_screen);
     
-    printf("DEBUG: Cleaning up texture manager...\n");
+    LOG_DEBUG(LOG_GAME, "Cleaning up texture manager...");
     texture_manager_cleanup(&game->texture_manager);
+    replay_free(&game->replay);
     
-    printf("DEBUG: Quitting TTF...\n");
+    audio_cleanup();
+    
+    // Still needs TTF for its font
+    profiler_cleanup(&game->profiler);
+    
+    LOG_DEBUG(LOG_GAME, "Quitting TTF...");
     TTF_Quit();
     
-    printf("DEBUG: Quitting mixer...\n");
+    LOG_DEBUG(LOG_GAME, "Quitting mixer...");
     Mix_Quit();
     
-    printf("DEBUG: Quitting IMG...\n");
+    LOG_DEBUG(LOG_GAME, "Quitting IMG...");
     IMG_Quit();
     
-    printf("DEBUG: Destroying renderer...\n");
+    LOG_DEBUG(LOG_GAME, "Destroying renderer...");
     if (game->renderer) {
         SDL_DestroyRenderer(game->renderer);
         game->renderer = NULL;
     }
     
-    printf("DEBUG: Destroying window...\n");
+    LOG_DEBUG(LOG_GAME, "Destroying window...");
     if (game->window) {
         SDL_DestroyWindow(game->window);
         game->window = NULL;
     }
     
-    printf("DEBUG: Quitting SDL...\n");
+    // Asset workers have been joined, so every ring is complete
+    TRACE_SHUTDOWN();
+    
+    LOG_DEBUG(LOG_GAME, "Quitting SDL...");
     SDL_Quit();
     
-    printf("DEBUG: Cleanup complete.\n");
+    LOG_DEBUG(LOG_GAME, "Cleanup complete.");
 }
 
 void game_handle_events(Game* game) {
@@ -139,11 +320,23 @@ void game_handle_events(Game* game) {
             game->running = false;
         }
         
+        // Render targets lose their contents (or the whole texture) on reset
+        if ((e.type == SDL_RENDER_TARGETS_RESET || e.type == SDL_RENDER_DEVICE_RESET)) {
+            brick_grid_invalidate_layer(&game->gameplay.brick_grid, e.type == SDL_RENDER_DEVICE_RESET);
+        }
+        
         if (e.type == SDL_KEYDOWN) {
             switch (e.key.keysym.sym) {
                 case SDLK_ESCAPE:
                     game->running = false;
                     break;
+                case SDLK_F3:
+                    profiler_toggle(&game->profiler);
+                    break;
+                case SDLK_F4:
+                    // Only with `make TRACE=1`
+                    TRACE_DUMP(NULL);
+                    break;
             }
         }
         
@@ -153,22 +346,15 @@ void game_handle_events(Game* game) {
                 title_screen_handle_input(&game->title_screen, &e, &next_state);
                 if (next_state == GAME_STATE_GAMEPLAY) {
                     // Reset game when starting new game from title
-                    gameplay_reset_game(&game->gameplay);
+                    game_start_gameplay(game);
                 }
-                game->current_state = next_state;
+                game_change_state(game, next_state);
                 break;
             }
             case GAME_STATE_GAMEPLAY: {
                 int next_state = game->current_state;
                 gameplay_handle_input(&game->gameplay, &e, &next_state);
-                if (next_state == GAME_STATE_COMPLETE) {
-                    // Initialize complete screen when transitioning from input
-                    printf("DEBUG: Input triggered complete state, initializing complete screen\n");
-                    fflush(stdout);
-                    complete_screen_init(&game->complete_screen, &game->texture_manager, 
-                                       game->gameplay.score);
-                }
-                game->current_state = next_state;
+                game_change_state(game, next_state);
                 break;
             }
             case GAME_STATE_GAMEOVER: {
@@ -176,25 +362,20 @@ void game_handle_events(Game* game) {
                 gameover_screen_handle_input(&game->gameover_screen, &e, &next_state);
                 if (next_state == GAME_STATE_GAMEPLAY) {
                     // Reset game when retrying
-                    gameplay_reset_game(&game->gameplay);
+                    game_start_gameplay(game);
                 }
-                game->current_state = next_state;
+                game_change_state(game, next_state);
                 break;
             }
             case GAME_STATE_COMPLETE: {
-                printf("DEBUG: Handling input for complete screen\n");
-                fflush(stdout);
                 int next_state = game->current_state;
                 complete_screen_handle_input(&game->complete_screen, &e, &next_state);
                 if (next_state == GAME_STATE_GAMEPLAY) {
                     // Reset game when playing again
-                    printf("DEBUG: Resetting game for play again\n");
-                    fflush(stdout);
-                    gameplay_reset_game(&game->gameplay);
+                    LOG_DEBUG(LOG_GAME, "Resetting game for play again");
+                    game_start_gameplay(game);
                 }
-                game->current_state = next_state;
-                printf("DEBUG: Complete screen input handled\n");
-                fflush(stdout);
+                game_change_state(game, next_state);
                 break;
             }
             case GAME_STATE_QUIT:
@@ -211,32 +392,57 @@ void game_update(Game* game) {
             break;
         case GAME_STATE_GAMEPLAY: {
             int next_state = game->current_state;
-            gameplay_update(&game->gameplay, game->delta_time, &next_state);
+            GameplayInput input;
+            if (game->options.replay_path) {
+                // Keys pressed while watching a replay don't reach the simulation
+                game->gameplay.pending_commands = 0;
+                if (!replay_input(&game->replay, game->replay_tick, &input)) {
+                    game_finish_run(game);
+                    break;
+                }
+                game->replay_tick++;
+            } else {
+                if (game->options.autoplay) {
+                    autoplay_input(&game->gameplay, &input);
+                } else {
+                    const Uint8* keyboard_state = SDL_GetKeyboardState(NULL);
+                    input.left = keyboard_state[SDL_SCANCODE_LEFT] != 0;
+                    input.right = keyboard_state[SDL_SCANCODE_RIGHT] != 0;
+                }
+                // Space and P still work, so a watched run can be paused or skipped ahead
+                input.commands = game->gameplay.pending_commands;
+                game->gameplay.pending_commands = 0;
+                if (game->options.record_path) {
+                    replay_record(&game->replay, &input);
+                }
+            }
+            gameplay_update(&game->gameplay, &input, game->delta_time, &next_state);
             if (next_state == GAME_STATE_GAMEOVER) {
                 // Initialize game over screen with final stats
-                printf("DEBUG: Initializing game over screen\n");
+                LOG_DEBUG(LOG_GAME, "Game over at stage %d with score: %d",
+                          game->gameplay.stage, game->gameplay.score);
                 gameover_screen_init(&game->gameover_screen, &game->texture_manager, 
                                    game->gameplay.score, game->gameplay.stage);
-                printf("DEBUG: Game over screen initialized\n");
             } else if (next_state == GAME_STATE_COMPLETE) {
                 // Initialize complete screen with final score
-                printf("DEBUG: Initializing complete screen with score: %d\n", game->gameplay.score);
-                fflush(stdout);
+                LOG_DEBUG(LOG_GAME, "Game complete with score: %d", game->gameplay.score);
                 complete_screen_init(&game->complete_screen, &game->texture_manager, 
                                    game->gameplay.score);
-                printf("DEBUG: Complete screen initialized\n");
-                fflush(stdout);
             }
-            game->current_state = next_state;
+            game_change_state(game, next_state);
             break;
         }
         case GAME_STATE_GAMEOVER:
             gameover_screen_update(&game->gameover_screen, game->delta_time);
+            if (game->options.autoplay) {
+                game_autoplay_next_run(game);
+            }
             break;
         case GAME_STATE_COMPLETE:
-            printf("DEBUG: Updating complete screen\n");
             complete_screen_update(&game->complete_screen, game->delta_time);
-            printf("DEBUG: Complete screen updated\n");
+            if (game->options.autoplay) {
+                game_autoplay_next_run(game);
+            }
             break;
         case GAME_STATE_QUIT:
             game->running = false;
@@ -245,6 +451,8 @@ void game_update(Game* game) {
 }
 
 void game_render(Game* game) {
+    sprite_batch_begin_frame(&game->texture_manager.sprites);
+    
     SDL_SetRenderDrawColor(game->renderer, 15, 174, 188, 255);
     SDL_RenderClear(game->renderer);
     
@@ -253,19 +461,20 @@ void game_render(Game* game) {
             title_screen_render(&game->title_screen, game->renderer);
             break;
         case GAME_STATE_GAMEPLAY:
-            gameplay_render(&game->gameplay, game->renderer);
+            gameplay_render(&game->gameplay, game->renderer, game->render_alpha);
             break;
         case GAME_STATE_GAMEOVER:
             gameover_screen_render(&game->gameover_screen, game->renderer);
             break;
         case GAME_STATE_COMPLETE:
-            printf("DEBUG: Rendering complete screen\n");
             complete_screen_render(&game->complete_screen, game->renderer);
-            printf("DEBUG: Complete screen rendered\n");
             break;
         case GAME_STATE_QUIT:
             break;
     }
     
-    SDL_RenderPresent(game->renderer);
+    profiler_render(&game->profiler, &game->texture_manager);
+    
+    // Screens leave their last sprites and text queued; game_run presents
+    sprite_batch_flush(&game->texture_manager.sprites);
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "gameover_screen.h"
+#include "log.h"
 #include "game.h"
 #include <stdio.h>
 
@@ -8,8 +9,23 @@ void gameover_screen_init(GameOverScreen* gos, TextureManager* tm, int score, in
     gos->final_score = score;
     gos->final_stage = stage;
     
+    gos->background = asset_acquire(&tm->assets, "background");
+    gos->kion_ded = asset_acquire(&tm->assets, "kion_ded");
+    gos->arrow = asset_acquire(&tm->assets, "arrow");
+    gos->menu_select = asset_acquire(&tm->assets, "sfx_menu_select");
+    gos->bgm = asset_acquire(&tm->assets, "bgm_gameover");
+    
     // Start game over BGM
-    play_bgm(tm->bgm_gameover);
+    asset_play_music(&tm->assets, gos->bgm);
+}
+
+void gameover_screen_cleanup(GameOverScreen* gos) {
+    AssetRegistry* assets = &gos->texture_manager->assets;
+    asset_release(assets, gos->background);
+    asset_release(assets, gos->kion_ded);
+    asset_release(assets, gos->arrow);
+    asset_release(assets, gos->menu_select);
+    asset_release(assets, gos->bgm);
 }
 
 void gameover_screen_handle_input(GameOverScreen* gos, SDL_Event* e, int* next_state) {
@@ -17,15 +33,15 @@ void gameover_screen_handle_input(GameOverScreen* gos, SDL_Event* e, int* next_s
         switch (e->key.keysym.sym) {
             case SDLK_UP:
                 gos->current_option = (gos->current_option - 1 + GAMEOVER_MENU_COUNT) % GAMEOVER_MENU_COUNT;
-                play_sfx(gos->texture_manager->sfx_menu_select);
+                asset_play_sound(&gos->texture_manager->assets, gos->menu_select);
                 break;
             case SDLK_DOWN:
                 gos->current_option = (gos->current_option + 1) % GAMEOVER_MENU_COUNT;
-                play_sfx(gos->texture_manager->sfx_menu_select);
+                asset_play_sound(&gos->texture_manager->assets, gos->menu_select);
                 break;
             case SDLK_RETURN:
             case SDLK_SPACE:
-                play_sfx(gos->texture_manager->sfx_menu_select);
+                asset_play_sound(&gos->texture_manager->assets, gos->menu_select);
                 if (gos->current_option == GAMEOVER_RETRY) {
                     *next_state = GAME_STATE_GAMEPLAY;
                 } else if (gos->current_option == GAMEOVER_QUIT) {
@@ -46,9 +62,14 @@ void gameover_screen_update(GameOverScreen* gos, float delta_time) {
 }
 
 void gameover_screen_render(GameOverScreen* gos, SDL_Renderer* renderer) {
+    AssetRegistry* assets = &gos->texture_manager->assets;
+    const Texture* background = asset_texture(assets, gos->background);
+    const Texture* kion_ded = asset_texture(assets, gos->kion_ded);
+    const Texture* arrow = asset_texture(assets, gos->arrow);
+    
     // Render background (muted)
-    if (gos->texture_manager->background.texture) {
-        render_texture(renderer, gos->texture_manager->background.texture, 
+    if (background->texture) {
+        render_texture(renderer, background->texture, 
                       0, 0, WINDOW_WIDTH, WINDOW_HEIGHT);
     }
     
@@ -60,13 +81,13 @@ void gameover_screen_render(GameOverScreen* gos, SDL_Renderer* renderer) {
     SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
     
     // Render Kion defeated character
-    if (gos->texture_manager->kion_ded.texture) {
+    if (kion_ded->texture) {
         int kion_scale = 1; // Reduced from 3 to 1 (about half size)
-        int kion_width = gos->texture_manager->kion_ded.width * kion_scale;
-        int kion_height = gos->texture_manager->kion_ded.height * kion_scale;
+        int kion_width = kion_ded->width * kion_scale;
+        int kion_height = kion_ded->height * kion_scale;
         int kion_x = 20; // Left side
         int kion_y = WINDOW_HEIGHT - kion_height; // Flush with bottom
-        render_texture(renderer, gos->texture_manager->kion_ded.texture, 
+        render_texture(renderer, kion_ded->texture, 
                       kion_x, kion_y, kion_width, kion_height);
     }
     
@@ -76,14 +97,11 @@ void gameover_screen_render(GameOverScreen* gos, SDL_Renderer* renderer) {
         
         char gameover_text[] = "Game Over";
         int title_width, title_height;
-        SDL_Texture* title_texture = create_text_texture(renderer, gos->texture_manager->font_title, 
-                                                        gameover_text, red_color, &title_width, &title_height);
-        if (title_texture) {
-            int title_x = (WINDOW_WIDTH - title_width) / 2;
-            int title_y = 100;
-            render_texture(renderer, title_texture, title_x, title_y, title_width, title_height);
-            SDL_DestroyTexture(title_texture);
-        }
+        measure_text(gos->texture_manager, gos->texture_manager->font_title, 
+                     gameover_text, &title_width, &title_height);
+        int title_x = (WINDOW_WIDTH - title_width) / 2;
+        draw_text(gos->texture_manager, gos->texture_manager->font_title, 
+                  gameover_text, title_x, 100, red_color);
     }
     
     // Render final score and stage
@@ -93,26 +111,20 @@ void gameover_screen_render(GameOverScreen* gos, SDL_Renderer* renderer) {
         char score_text[64];
         sprintf(score_text, "Final Score: %d", gos->final_score);
         int score_width, score_height;
-        SDL_Texture* score_texture = create_text_texture(renderer, gos->texture_manager->font_regular, 
-                                                        score_text, white_color, &score_width, &score_height);
-        if (score_texture) {
-            int score_x = (WINDOW_WIDTH - score_width) / 2;
-            int score_y = 180;
-            render_texture(renderer, score_texture, score_x, score_y, score_width, score_height);
-            SDL_DestroyTexture(score_texture);
-        }
+        measure_text(gos->texture_manager, gos->texture_manager->font_regular, 
+                     score_text, &score_width, &score_height);
+        int score_x = (WINDOW_WIDTH - score_width) / 2;
+        draw_text(gos->texture_manager, gos->texture_manager->font_regular, 
+                  score_text, score_x, 180, white_color);
         
         char stage_text[64];
         sprintf(stage_text, "Reached Stage: %d", gos->final_stage);
         int stage_width, stage_height;
-        SDL_Texture* stage_texture = create_text_texture(renderer, gos->texture_manager->font_regular, 
-                                                        stage_text, white_color, &stage_width, &stage_height);
-        if (stage_texture) {
-            int stage_x = (WINDOW_WIDTH - stage_width) / 2;
-            int stage_y = 220;
-            render_texture(renderer, stage_texture, stage_x, stage_y, stage_width, stage_height);
-            SDL_DestroyTexture(stage_texture);
-        }
+        measure_text(gos->texture_manager, gos->texture_manager->font_regular, 
+                     stage_text, &stage_width, &stage_height);
+        int stage_x = (WINDOW_WIDTH - stage_width) / 2;
+        draw_text(gos->texture_manager, gos->texture_manager->font_regular, 
+                  stage_text, stage_x, 220, white_color);
     }
     
     // Render menu options
@@ -127,20 +139,18 @@ void gameover_screen_render(GameOverScreen* gos, SDL_Renderer* renderer) {
             int text_width, text_height;
             SDL_Color text_color = (i == (int)gos->current_option) ? green_color : white_color;
             
-            SDL_Texture* text_texture = create_text_texture(renderer, gos->texture_manager->font_regular, 
-                                                           menu_items[i], text_color, &text_width, &text_height);
-            if (text_texture) {
-                int text_x = menu_x;
-                int text_y = menu_y + i * 50;
-                render_texture(renderer, text_texture, text_x, text_y, text_width, text_height);
-                SDL_DestroyTexture(text_texture);
-                
-                if (i == (int)gos->current_option && gos->texture_manager->arrow.texture) {
-                    int arrow_x = menu_x - 40;
-                    int arrow_y = text_y + (text_height - gos->texture_manager->arrow.height) / 2;
-                    render_texture(renderer, gos->texture_manager->arrow.texture, 
-                                  arrow_x, arrow_y, gos->texture_manager->arrow.width, gos->texture_manager->arrow.height);
-                }
+            int text_x = menu_x;
+            int text_y = menu_y + i * 50;
+            measure_text(gos->texture_manager, gos->texture_manager->font_regular, 
+                         menu_items[i], &text_width, &text_height);
+            draw_text(gos->texture_manager, gos->texture_manager->font_regular, 
+                      menu_items[i], text_x, text_y, text_color);
+            
+            if (i == (int)gos->current_option && arrow->texture) {
+                int arrow_x = menu_x - 40;
+                int arrow_y = text_y + (text_height - arrow->height) / 2;
+                draw_sprite(gos->texture_manager, arrow,
+                            arrow_x, arrow_y, arrow->width, arrow->height);
             }
         }
     }
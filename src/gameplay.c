@@ -1,51 +1,102 @@
 #include "gameplay.h"
+#include "log.h"
 #include "game.h"
+#include "trace.h"
 #include <math.h>
 #include <stdio.h>
+#include <string.h>
 
-Mix_Music* get_stage_bgm(TextureManager* tm, int stage) {
-    switch (stage) {
-        case 1: return tm->bgm_stage1;
-        case 2: return tm->bgm_stage2;
-        case 3: return tm->bgm_stage3;
-        case 4: return tm->bgm_stage4;
-        case 5: return tm->bgm_stage5;
-        default: return tm->bgm_stage1;
+// Brick contacts resolved within a single simulation step
+#define MAX_BRICK_CONTACTS 8
+
+static void gameplay_emit(Gameplay* gp, GameplayEvent event) {
+    if (gp->on_event) {
+        gp->on_event(gp, event, gp->event_user_data);
+    }
+}
+
+static void gameplay_on_brick_event(BrickEvent event, int index, void* user_data) {
+    Gameplay* gp = user_data;
+    (void)index;
+    
+    // Acted on at the end of the step, once the ball has finished moving
+    if (event == BRICK_EVENT_STAGE_CLEARED) {
+        gp->stage_cleared = true;
+    }
+}
+
+static Uint32 gameplay_random(Gameplay* gp) {
+    // xorshift32; the state is never zero once seeded
+    Uint32 x = gp->rng_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    gp->rng_state = x;
+    return x;
+}
+
+static Uint32 gameplay_hash(Uint32 hash, const void* data, size_t size) {
+    // 32-bit FNV-1a
+    const Uint8* bytes = data;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
     }
+    return hash;
 }
 
-void gameplay_init(Gameplay* gp, TextureManager* tm) {
-    gp->texture_manager = tm;
+void gameplay_init(Gameplay* gp) {
+    memset(gp, 0, sizeof(*gp));
+    gameplay_seed(gp, 1);
     gp->lives = 3;
     gp->score = 0;
     gp->stage = 1;
-    gp->paused = false;
-    
-    // Start stage 1 BGM
-    play_bgm(get_stage_bgm(tm, 1));
     
     // Initialize paddle
     float paddle_x = (WINDOW_WIDTH - 64) / 2.0f;
     float paddle_y = WINDOW_HEIGHT - 40;
-    paddle_init(&gp->paddle, paddle_x, paddle_y, tm->paddle.texture);
+    paddle_init(&gp->paddle, paddle_x, paddle_y);
     
     // Initialize ball
     float ball_x = (WINDOW_WIDTH - 16) / 2.0f;
     float ball_y = paddle_y - 20;
-    ball_init(&gp->ball, ball_x, ball_y, tm->ball.texture);
+    ball_init(&gp->ball, ball_x, ball_y);
     
-    // Initialize brick grid  
-    SDL_Texture* brick_textures[BRICK_TYPES_COUNT] = {
-        tm->brick_red.texture,     // BRICK_RED
-        tm->brick_yellow.texture,  // BRICK_ORANGE (using yellow for now)
-        tm->brick_yellow.texture,  // BRICK_YELLOW
-        tm->brick_green.texture,   // BRICK_GREEN
-        tm->brick_blue.texture     // BRICK_BLUE
-    };
-    brick_grid_init(&gp->brick_grid, brick_textures);
+    // Initialize brick grid; the view hands it textures
+    brick_grid_init(&gp->brick_grid, NULL);
+    brick_grid_set_event_callback(&gp->brick_grid, gameplay_on_brick_event, gp);
     brick_grid_create_stage(&gp->brick_grid, gp->stage);
 }
 
+void gameplay_cleanup(Gameplay* gp) {
+    brick_grid_cleanup(&gp->brick_grid);
+}
+
+void gameplay_set_event_callback(Gameplay* gp, GameplayEventCallback callback, void* user_data) {
+    gp->on_event = callback;
+    gp->event_user_data = user_data;
+}
+
+void gameplay_seed(Gameplay* gp, Uint32 seed) {
+    gp->rng_state = seed ? seed : 0x9e3779b9u;
+}
+
+Uint32 gameplay_state_hash(const Gameplay* gp) {
+    // Everything the simulation carries from one step to the next
+    Uint32 hash = 2166136261u;
+    hash = gameplay_hash(hash, &gp->ball.x, sizeof(gp->ball.x));
+    hash = gameplay_hash(hash, &gp->ball.y, sizeof(gp->ball.y));
+    hash = gameplay_hash(hash, &gp->ball.vel_x, sizeof(gp->ball.vel_x));
+    hash = gameplay_hash(hash, &gp->ball.vel_y, sizeof(gp->ball.vel_y));
+    hash = gameplay_hash(hash, &gp->paddle.x, sizeof(gp->paddle.x));
+    hash = gameplay_hash(hash, &gp->lives, sizeof(gp->lives));
+    hash = gameplay_hash(hash, &gp->score, sizeof(gp->score));
+    hash = gameplay_hash(hash, &gp->stage, sizeof(gp->stage));
+    hash = gameplay_hash(hash, &gp->rng_state, sizeof(gp->rng_state));
+    hash = gameplay_hash(hash, gp->brick_grid.live, sizeof(Uint64) * ((gp->brick_grid.count + 63) / 64));
+    return hash;
+}
+
 void gameplay_handle_input(Gameplay* gp, SDL_Event* e, int* next_state) {
     if (e->type == SDL_KEYDOWN) {
         switch (e->key.keysym.sym) {
@@ -54,52 +105,66 @@ void gameplay_handle_input(Gameplay* gp, SDL_Event* e, int* next_state) {
                 break;
             case SDLK_SPACE:
                 // Advance to next stage
-                printf("DEBUG: Space pressed, current stage: %d\n", gp->stage);
-                fflush(stdout);
-                gp->stage++;
-                printf("DEBUG: Stage incremented to: %d\n", gp->stage);
-                fflush(stdout);
-                if (gp->stage > 5) {
-                    // All stages complete - trigger game complete state
-                    printf("DEBUG: Triggering GAME_STATE_COMPLETE\n");
-                    fflush(stdout);
-                    *next_state = GAME_STATE_COMPLETE;
-                } else {
-                    printf("DEBUG: Creating stage %d\n", gp->stage);
-                    brick_grid_create_stage(&gp->brick_grid, gp->stage);
-                    gameplay_reset_ball(gp);
-                    printf("DEBUG: Stage %d created and ball reset\n", gp->stage);
-                }
+                gp->pending_commands |= GAMEPLAY_COMMAND_NEXT_STAGE;
                 break;
             case SDLK_p:
                 // Toggle pause
-                gp->paused = !gp->paused;
+                gp->pending_commands |= GAMEPLAY_COMMAND_TOGGLE_PAUSE;
                 break;
         }
     }
 }
 
-void gameplay_update(Gameplay* gp, float delta_time, int* next_state) {
+static void gameplay_apply_commands(Gameplay* gp, Uint8 commands, int* next_state) {
+    if (commands & GAMEPLAY_COMMAND_TOGGLE_PAUSE) {
+        gp->paused = !gp->paused;
+    }
+    if (commands & GAMEPLAY_COMMAND_NEXT_STAGE) {
+        LOG_DEBUG(LOG_GAMEPLAY, "Skipping stage %d", gp->stage);
+        gp->stage++;
+        if (gp->stage > GAMEPLAY_STAGE_COUNT) {
+            // All stages complete - trigger game complete state
+            *next_state = GAME_STATE_COMPLETE;
+        } else {
+            brick_grid_create_stage(&gp->brick_grid, gp->stage);
+            gameplay_reset_ball(gp);
+            gameplay_emit(gp, GAMEPLAY_EVENT_STAGE_STARTED);
+        }
+    }
+}
+
+void gameplay_update(Gameplay* gp, const GameplayInput* input, float delta_time, int* next_state) {
+    TRACE_SCOPE("gameplay_update");
+    
+    // Keep the previous step's positions for interpolated rendering
+    gp->ball.prev_x = gp->ball.x;
+    gp->ball.prev_y = gp->ball.y;
+    gp->paddle.prev_x = gp->paddle.x;
+    gp->paddle.prev_y = gp->paddle.y;
+    
+    // Key presses are stepped like everything else so replays see them on the same tick
+    gameplay_apply_commands(gp, input->commands, next_state);
+    
     // Don't update game logic if paused
-    if (gp->paused) {
+    if (gp->paused || *next_state != GAME_STATE_GAMEPLAY) {
         return;
     }
     
-    const Uint8* keyboard_state = SDL_GetKeyboardState(NULL);
-    
     // Update paddle
-    paddle_update(&gp->paddle, keyboard_state, delta_time);
+    paddle_update(&gp->paddle, (int)input->right - (int)input->left, delta_time);
     
-    // Update ball
-    ball_update(&gp->ball, delta_time, gp->texture_manager);
-    
-    // Check collisions
+    // Move ball through the brick field, then against walls and paddle
+    gameplay_move_ball(gp, delta_time);
+    if (ball_check_walls(&gp->ball)) {
+        gameplay_emit(gp, GAMEPLAY_EVENT_BALL_WALL);
+    }
     gameplay_check_collisions(gp);
     
-    // Check if all bricks destroyed (stage complete)
-    if (brick_grid_all_destroyed(&gp->brick_grid)) {
+    // Last brick destroyed this step (stage complete)
+    if (gp->stage_cleared) {
+        gp->stage_cleared = false;
         gp->stage++;
-        if (gp->stage > 5) {
+        if (gp->stage > GAMEPLAY_STAGE_COUNT) {
             // All stages complete - trigger game complete state
             *next_state = GAME_STATE_COMPLETE;
         } else {
@@ -109,7 +174,7 @@ void gameplay_update(Gameplay* gp, float delta_time, int* next_state) {
             gp->score += 100; // Bonus for completing stage
             
             // Change BGM for new stage
-            play_bgm(get_stage_bgm(gp->texture_manager, gp->stage));
+            gameplay_emit(gp, GAMEPLAY_EVENT_STAGE_STARTED);
         }
     }
     
@@ -118,7 +183,7 @@ void gameplay_update(Gameplay* gp, float delta_time, int* next_state) {
         gp->lives--;
         
         // Play lose life SFX
-        play_sfx(gp->texture_manager->sfx_lose_life);
+        gameplay_emit(gp, GAMEPLAY_EVENT_LIFE_LOST);
         
         if (gp->lives <= 0) {
             gp->lives = 0; // Prevent negative lives
@@ -129,92 +194,11 @@ void gameplay_update(Gameplay* gp, float delta_time, int* next_state) {
     }
 }
 
-void gameplay_render(Gameplay* gp, SDL_Renderer* renderer) {
-    // Render background
-    if (gp->texture_manager->background.texture) {
-        render_texture(renderer, gp->texture_manager->background.texture, 
-                      0, 0, WINDOW_WIDTH, WINDOW_HEIGHT);
-    }
-    
-    // Render black header space
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-    SDL_Rect header_rect = {0, 0, WINDOW_WIDTH, 60};
-    SDL_RenderFillRect(renderer, &header_rect);
-    
-    // Render UI text (lives and score)
-    if (gp->texture_manager->font_regular) {
-        SDL_Color white_color = {255, 255, 255, 255};
-        
-        // Lives display
-        char lives_text[32];
-        sprintf(lives_text, "Lives: %d", gp->lives);
-        int lives_width, lives_height;
-        SDL_Texture* lives_texture = create_text_texture(renderer, gp->texture_manager->font_regular, 
-                                                        lives_text, white_color, &lives_width, &lives_height);
-        if (lives_texture) {
-            render_texture(renderer, lives_texture, 10, 20, lives_width, lives_height);
-            SDL_DestroyTexture(lives_texture);
-        }
-        
-        // Score display
-        char score_text[32];
-        sprintf(score_text, "Score: %d", gp->score);
-        int score_width, score_height;
-        SDL_Texture* score_texture = create_text_texture(renderer, gp->texture_manager->font_regular, 
-                                                        score_text, white_color, &score_width, &score_height);
-        if (score_texture) {
-            int score_x = WINDOW_WIDTH - score_width - 10;
-            render_texture(renderer, score_texture, score_x, 20, score_width, score_height);
-            SDL_DestroyTexture(score_texture);
-        }
-        
-        // Stage display (center)
-        char stage_text[32];
-        sprintf(stage_text, "Stage: %d", gp->stage);
-        int stage_width, stage_height;
-        SDL_Texture* stage_texture = create_text_texture(renderer, gp->texture_manager->font_regular, 
-                                                        stage_text, white_color, &stage_width, &stage_height);
-        if (stage_texture) {
-            int stage_x = (WINDOW_WIDTH - stage_width) / 2;
-            render_texture(renderer, stage_texture, stage_x, 20, stage_width, stage_height);
-            SDL_DestroyTexture(stage_texture);
-        }
-    }
-    
-    // Render game objects
-    brick_grid_render(&gp->brick_grid, renderer);
-    paddle_render(&gp->paddle, renderer);
-    ball_render(&gp->ball, renderer);
-    
-    // Render pause overlay
-    if (gp->paused && gp->texture_manager->font_regular) {
-        SDL_Color white_color = {255, 255, 255, 255};
-        
-        char pause_text[] = "PAUSED - Press P to Resume";
-        int pause_width, pause_height;
-        SDL_Texture* pause_texture = create_text_texture(renderer, gp->texture_manager->font_regular, 
-                                                        pause_text, white_color, &pause_width, &pause_height);
-        if (pause_texture) {
-            int pause_x = (WINDOW_WIDTH - pause_width) / 2;
-            int pause_y = (WINDOW_HEIGHT - pause_height) / 2;
-            
-            // Semi-transparent background
-            SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 128);
-            SDL_Rect pause_bg = {pause_x - 10, pause_y - 10, pause_width + 20, pause_height + 20};
-            SDL_RenderFillRect(renderer, &pause_bg);
-            
-            render_texture(renderer, pause_texture, pause_x, pause_y, pause_width, pause_height);
-            SDL_DestroyTexture(pause_texture);
-            SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
-        }
-    }
-}
-
 void gameplay_reset_ball(Gameplay* gp) {
     float ball_x = (WINDOW_WIDTH - 16) / 2.0f;
     float ball_y = gp->paddle.y - 20;
-    ball_reset(&gp->ball, ball_x, ball_y);
+    float angle_degrees = -60.0f + (float)(gameplay_random(gp) % 121); // -60 to +60
+    ball_reset(&gp->ball, ball_x, ball_y, angle_degrees);
 }
 
 void gameplay_reset_game(Gameplay* gp) {
@@ -222,16 +206,23 @@ void gameplay_reset_game(Gameplay* gp) {
     gp->score = 0;
     gp->stage = 1;
     gp->paused = false;
+    gp->stage_cleared = false;
+    gp->pending_commands = 0;
+    
+    // Every run starts from the same place, or replays of later runs drift
+    gp->paddle.x = (WINDOW_WIDTH - gp->paddle.width) / 2.0f;
+    gp->paddle.prev_x = gp->paddle.x;
     
     // Reset to stage 1
     brick_grid_create_stage(&gp->brick_grid, gp->stage);
     gameplay_reset_ball(gp);
     
     // Start stage 1 BGM
-    play_bgm(get_stage_bgm(gp->texture_manager, 1));
+    gameplay_emit(gp, GAMEPLAY_EVENT_STAGE_STARTED);
 }
 
 bool gameplay_check_collisions(Gameplay* gp) {
+    TRACE_SCOPE("gameplay_check_collisions");
     Ball* ball = &gp->ball;
     Paddle* paddle = &gp->paddle;
     
@@ -266,23 +257,51 @@ bool gameplay_check_collisions(Gameplay* gp) {
         ball->y = paddle->y - ball->height;
         
         // Play paddle hit SFX
-        play_sfx(gp->texture_manager->sfx_ball_paddle);
+        gameplay_emit(gp, GAMEPLAY_EVENT_BALL_PADDLE);
         
         return true;
     }
     
-    // Ball-brick collision
-    if (brick_grid_check_collision(&gp->brick_grid, ball->x, ball->y, ball->width, ball->height)) {
-        ball_bounce_y(ball, gp->texture_manager);
+    return false;
+}
+
+void gameplay_move_ball(Gameplay* gp, float delta_time) {
+    Ball* ball = &gp->ball;
+    float remaining = 1.0f; // Fraction of this step's movement still to apply
+    
+    // Sweep the ball along its path so fast balls can't skip bricks, and
+    // resolve each contact in time order
+    for (int contact = 0; contact < MAX_BRICK_CONTACTS; contact++) {
+        float move_x = ball->vel_x * delta_time * remaining;
+        float move_y = ball->vel_y * delta_time * remaining;
+        
+        BrickHit hit;
+        if (!brick_grid_sweep(&gp->brick_grid, ball->x, ball->y, ball->width, ball->height,
+                              move_x, move_y, &hit)) {
+            ball->x += move_x;
+            ball->y += move_y;
+            return;
+        }
+        
+        ball->x += move_x * hit.time;
+        ball->y += move_y * hit.time;
+        remaining *= 1.0f - hit.time;
+        
+        brick_grid_destroy_brick(&gp->brick_grid, hit.index);
+        
+        // Reflect on the face that was struck (both axes on a corner)
+        if (hit.normal_x != 0.0f) {
+            ball_bounce_x(ball);
+        }
+        if (hit.normal_y != 0.0f) {
+            ball_bounce_y(ball);
+        }
+        
         // Scoring: different points for different brick types and stages
         int brick_points = 10 + (gp->stage * 5); // Higher stages worth more
         gp->score += brick_points;
         
         // Play brick hit SFX
-        play_sfx(gp->texture_manager->sfx_ball_brick);
-        
-        return true;
+        gameplay_emit(gp, GAMEPLAY_EVENT_BALL_BRICK);
     }
-    
-    return false;
 }
\ No newline at end of file
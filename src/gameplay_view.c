@@ -0,0 +1,214 @@
+#include "gameplay.h"
+#include "log.h"
+#include "game.h"
+#include <stdio.h>
+
+// Manifest names for each brick type, orange borrowing yellow for now
+static const char* brick_sprite_names[BRICK_TYPES_COUNT] = {
+    "brick_red",     // BRICK_RED
+    "brick_yellow",  // BRICK_ORANGE
+    "brick_yellow",  // BRICK_YELLOW
+    "brick_green",   // BRICK_GREEN
+    "brick_blue"     // BRICK_BLUE
+};
+
+// The track after the last stage is the one the complete screen plays
+static void get_stage_bgm(int stage, char* name, size_t size) {
+    if (stage > GAMEPLAY_STAGE_COUNT) {
+        snprintf(name, size, "bgm_complete");
+    } else {
+        snprintf(name, size, "bgm_stage%d", stage < 1 ? 1 : stage);
+    }
+}
+
+// Play the current stage's track and start loading the next one behind it.
+// New references are taken before the old ones go, so a prefetched track
+// carries over instead of being evicted and loaded again.
+static void gameplay_play_stage_bgm(Gameplay* gp) {
+    AssetRegistry* assets = &gp->texture_manager->assets;
+    AssetId previous = gp->stage_bgm;
+    AssetId previous_next = gp->next_bgm;
+    char name[ASSET_NAME_MAX];
+    
+    get_stage_bgm(gp->stage, name, sizeof(name));
+    gp->stage_bgm = asset_acquire(assets, name);
+    asset_play_music(assets, gp->stage_bgm);
+    
+    get_stage_bgm(gp->stage + 1, name, sizeof(name));
+    gp->next_bgm = asset_acquire(assets, name);
+    
+    asset_release(assets, previous);
+    asset_release(assets, previous_next);
+}
+
+// Called when another screen takes over. Later stage tracks are dropped,
+// but stage 1 stays held since a new run starts there.
+void gameplay_leave(Gameplay* gp) {
+    AssetRegistry* assets = &gp->texture_manager->assets;
+    AssetId previous = gp->stage_bgm;
+    AssetId previous_next = gp->next_bgm;
+    
+    gp->stage_bgm = ASSET_ID_NONE;
+    gp->next_bgm = asset_acquire(assets, "bgm_stage1");
+    
+    asset_release(assets, previous);
+    asset_release(assets, previous_next);
+}
+
+static void gameplay_view_on_event(Gameplay* gp, GameplayEvent event, void* user_data) {
+    AssetRegistry* assets = user_data;
+    switch (event) {
+        case GAMEPLAY_EVENT_BALL_PADDLE:
+            asset_play_sound(assets, gp->sfx_ball_paddle);
+            break;
+        case GAMEPLAY_EVENT_BALL_WALL:
+            asset_play_sound(assets, gp->sfx_ball_wall);
+            break;
+        case GAMEPLAY_EVENT_BALL_BRICK:
+            asset_play_sound(assets, gp->sfx_ball_brick);
+            break;
+        case GAMEPLAY_EVENT_LIFE_LOST:
+            asset_play_sound(assets, gp->sfx_lose_life);
+            break;
+        case GAMEPLAY_EVENT_STAGE_STARTED:
+            gameplay_play_stage_bgm(gp);
+            break;
+    }
+}
+
+void gameplay_view_init(Gameplay* gp, TextureManager* tm) {
+    gp->texture_manager = tm;
+    
+    // Taken up front so they load behind the title screen. Of the music only
+    // stage 1 is prefetched; gameplay_reset_game starts it
+    AssetRegistry* assets = &tm->assets;
+    gp->background = asset_acquire(assets, "background");
+    gp->ball_sprite = asset_acquire(assets, "ball");
+    gp->paddle_sprite = asset_acquire(assets, "paddle");
+    for (int i = 0; i < BRICK_TYPES_COUNT; i++) {
+        gp->brick_sprites[i] = asset_acquire(assets, brick_sprite_names[i]);
+    }
+    gp->sfx_ball_paddle = asset_acquire(assets, "sfx_ball_paddle");
+    gp->sfx_ball_brick = asset_acquire(assets, "sfx_ball_brick");
+    gp->sfx_ball_wall = asset_acquire(assets, "sfx_ball_wall");
+    gp->sfx_lose_life = asset_acquire(assets, "sfx_lose_life");
+    gp->stage_bgm = ASSET_ID_NONE;
+    gp->next_bgm = asset_acquire(assets, "bgm_stage1");
+    
+    // Textures stay empty until loaded, so these can be handed out now
+    gp->paddle.sprite = asset_texture(assets, gp->paddle_sprite);
+    gp->ball.sprite = asset_texture(assets, gp->ball_sprite);
+    for (int i = 0; i < BRICK_TYPES_COUNT; i++) {
+        gp->brick_grid.textures[i] = asset_texture(assets, gp->brick_sprites[i]);
+    }
+    brick_grid_invalidate_layer(&gp->brick_grid, false);
+    
+    gameplay_set_event_callback(gp, gameplay_view_on_event, assets);
+}
+
+void gameplay_view_wait_sprites(Gameplay* gp) {
+    AssetId sprites[2 + BRICK_TYPES_COUNT];
+    int count = 0;
+    sprites[count++] = gp->ball_sprite;
+    sprites[count++] = gp->paddle_sprite;
+    for (int i = 0; i < BRICK_TYPES_COUNT; i++) {
+        sprites[count++] = gp->brick_sprites[i];
+    }
+    asset_registry_wait_for(&gp->texture_manager->assets, sprites, count);
+}
+
+void gameplay_view_cleanup(Gameplay* gp) {
+    gameplay_set_event_callback(gp, NULL, NULL);
+    gp->paddle.sprite = NULL;
+    gp->ball.sprite = NULL;
+    for (int i = 0; i < BRICK_TYPES_COUNT; i++) {
+        gp->brick_grid.textures[i] = NULL;
+    }
+    
+    AssetRegistry* assets = &gp->texture_manager->assets;
+    asset_release(assets, gp->background);
+    asset_release(assets, gp->ball_sprite);
+    asset_release(assets, gp->paddle_sprite);
+    for (int i = 0; i < BRICK_TYPES_COUNT; i++) {
+        asset_release(assets, gp->brick_sprites[i]);
+    }
+    asset_release(assets, gp->sfx_ball_paddle);
+    asset_release(assets, gp->sfx_ball_brick);
+    asset_release(assets, gp->sfx_ball_wall);
+    asset_release(assets, gp->sfx_lose_life);
+    asset_release(assets, gp->stage_bgm);
+    asset_release(assets, gp->next_bgm);
+}
+
+void gameplay_render(Gameplay* gp, SDL_Renderer* renderer, float alpha) {
+    SpriteBatch* batch = &gp->texture_manager->sprites;
+    SDL_Color white = {255, 255, 255, 255};
+    
+    // Render background
+    const Texture* background = asset_texture(&gp->texture_manager->assets, gp->background);
+    if (background->texture) {
+        sprite_batch_draw(batch, background->texture, NULL,
+                          0, 0, WINDOW_WIDTH, WINDOW_HEIGHT, white);
+    }
+    sprite_batch_flush(batch);
+    
+    // Render black header space
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_Rect header_rect = {0, 0, WINDOW_WIDTH, 60};
+    SDL_RenderFillRect(renderer, &header_rect);
+    
+    // Render UI text (lives and score)
+    if (gp->texture_manager->font_regular) {
+        SDL_Color white_color = {255, 255, 255, 255};
+        TextureManager* tm = gp->texture_manager;
+        
+        // Lives display
+        char lives_text[32];
+        sprintf(lives_text, "Lives: %d", gp->lives);
+        draw_text(tm, tm->font_regular, lives_text, 10, 20, white_color);
+        
+        // Score display
+        char score_text[32];
+        sprintf(score_text, "Score: %d", gp->score);
+        int score_width, score_height;
+        measure_text(tm, tm->font_regular, score_text, &score_width, &score_height);
+        int score_x = WINDOW_WIDTH - score_width - 10;
+        draw_text(tm, tm->font_regular, score_text, score_x, 20, white_color);
+        
+        // Stage display (center)
+        char stage_text[32];
+        sprintf(stage_text, "Stage: %d", gp->stage);
+        int stage_width, stage_height;
+        measure_text(tm, tm->font_regular, stage_text, &stage_width, &stage_height);
+        int stage_x = (WINDOW_WIDTH - stage_width) / 2;
+        draw_text(tm, tm->font_regular, stage_text, stage_x, 20, white_color);
+    }
+    
+    // Render game objects
+    brick_grid_render(&gp->brick_grid, batch);
+    paddle_render(&gp->paddle, batch, alpha);
+    ball_render(&gp->ball, batch, alpha);
+    sprite_batch_flush(batch);
+    
+    // Render pause overlay
+    if (gp->paused && gp->texture_manager->font_regular) {
+        SDL_Color white_color = {255, 255, 255, 255};
+        
+        char pause_text[] = "PAUSED - Press P to Resume";
+        int pause_width, pause_height;
+        measure_text(gp->texture_manager, gp->texture_manager->font_regular, 
+                     pause_text, &pause_width, &pause_height);
+        int pause_x = (WINDOW_WIDTH - pause_width) / 2;
+        int pause_y = (WINDOW_HEIGHT - pause_height) / 2;
+        
+        // Semi-transparent background
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 128);
+        SDL_Rect pause_bg = {pause_x - 10, pause_y - 10, pause_width + 20, pause_height + 20};
+        SDL_RenderFillRect(renderer, &pause_bg);
+        
+        draw_text(gp->texture_manager, gp->texture_manager->font_regular, 
+                  pause_text, pause_x, pause_y, white_color);
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    }
+}
@@ -0,0 +1,141 @@
+#include "glyph_atlas.h"
+#include "log.h"
+#include <stdio.h>
+#include <string.h>
+
+static Glyph* glyph_lookup(GlyphAtlas* atlas, unsigned char c) {
+    if (c < GLYPH_FIRST || c > GLYPH_LAST) {
+        c = '?';
+    }
+    return &atlas->glyphs[c - GLYPH_FIRST];
+}
+
+int glyph_atlas_init(GlyphAtlas* atlas, SDL_Renderer* renderer, TTF_Font* font) {
+    memset(atlas, 0, sizeof(*atlas));
+    if (!font) return -1;
+    
+    atlas->font = font;
+    atlas->line_height = TTF_FontHeight(font);
+    
+    SDL_Color white_color = {255, 255, 255, 255};
+    SDL_Surface* glyph_surfaces[GLYPH_COUNT];
+    
+    // Rasterize each glyph and lay them out in shelves across the page
+    int pen_x = 0;
+    int pen_y = 0;
+    int shelf_height = 0;
+    for (int i = 0; i < GLYPH_COUNT; i++) {
+        Uint16 ch = (Uint16)(GLYPH_FIRST + i);
+        Glyph* glyph = &atlas->glyphs[i];
+        
+        int advance = 0;
+        if (TTF_GlyphMetrics(font, ch, NULL, NULL, NULL, NULL, &advance) == 0) {
+            glyph->advance = advance;
+        }
+        
+        glyph_surfaces[i] = TTF_RenderGlyph_Solid(font, ch, white_color);
+        if (!glyph_surfaces[i]) continue;
+        
+        int w = glyph_surfaces[i]->w;
+        int h = glyph_surfaces[i]->h;
+        if (pen_x + w > GLYPH_PAGE_WIDTH) {
+            pen_x = 0;
+            pen_y += shelf_height + 1;
+            shelf_height = 0;
+        }
+        
+        glyph->src.x = pen_x;
+        glyph->src.y = pen_y;
+        glyph->src.w = w;
+        glyph->src.h = h;
+        
+        pen_x += w + 1;
+        if (h > shelf_height) shelf_height = h;
+    }
+    
+    atlas->page_width = GLYPH_PAGE_WIDTH;
+    atlas->page_height = pen_y + shelf_height;
+    
+    SDL_Surface* page = NULL;
+    if (atlas->page_height > 0) {
+        page = SDL_CreateRGBSurfaceWithFormat(0, atlas->page_width, atlas->page_height, 32, SDL_PIXELFORMAT_RGBA32);
+    }
+    if (page) {
+        SDL_FillRect(page, NULL, 0);
+        for (int i = 0; i < GLYPH_COUNT; i++) {
+            if (glyph_surfaces[i]) {
+                SDL_Rect dest_rect = atlas->glyphs[i].src;
+                SDL_BlitSurface(glyph_surfaces[i], NULL, page, &dest_rect);
+            }
+        }
+        
+        atlas->texture = SDL_CreateTextureFromSurface(renderer, page);
+        if (!atlas->texture) {
+            LOG_ERROR(LOG_ASSETS, "Unable to create glyph atlas texture! SDL Error: %s", SDL_GetError());
+        } else {
+            SDL_SetTextureBlendMode(atlas->texture, SDL_BLENDMODE_BLEND);
+        }
+        SDL_FreeSurface(page);
+    }
+    
+    for (int i = 0; i < GLYPH_COUNT; i++) {
+        if (glyph_surfaces[i]) {
+            SDL_FreeSurface(glyph_surfaces[i]);
+        }
+    }
+    
+    return atlas->texture ? 0 : -1;
+}
+
+void glyph_atlas_cleanup(GlyphAtlas* atlas) {
+    if (atlas->texture) {
+        SDL_DestroyTexture(atlas->texture);
+        atlas->texture = NULL;
+    }
+    atlas->font = NULL;
+}
+
+void glyph_atlas_measure(GlyphAtlas* atlas, const char* text, int* width, int* height) {
+    int pen_x = 0;
+    int extent = 0;
+    Uint16 previous = 0;
+    
+    for (const unsigned char* p = (const unsigned char*)text; *p; p++) {
+        Glyph* glyph = glyph_lookup(atlas, *p);
+        Uint16 ch = (Uint16)(GLYPH_FIRST + (glyph - atlas->glyphs));
+        
+        if (previous) {
+            pen_x += TTF_GetFontKerningSizeGlyphs(atlas->font, previous, ch);
+        }
+        if (pen_x + glyph->src.w > extent) extent = pen_x + glyph->src.w;
+        pen_x += glyph->advance;
+        previous = ch;
+    }
+    
+    if (width) *width = pen_x > extent ? pen_x : extent;
+    if (height) *height = atlas->line_height;
+}
+
+void glyph_atlas_draw(GlyphAtlas* atlas, SpriteBatch* batch, const char* text, int x, int y, SDL_Color color) {
+    if (!atlas->texture || !text) return;
+    
+    int pen_x = x;
+    Uint16 previous = 0;
+    
+    for (const unsigned char* p = (const unsigned char*)text; *p; p++) {
+        Glyph* glyph = glyph_lookup(atlas, *p);
+        Uint16 ch = (Uint16)(GLYPH_FIRST + (glyph - atlas->glyphs));
+        
+        if (previous) {
+            pen_x += TTF_GetFontKerningSizeGlyphs(atlas->font, previous, ch);
+        }
+        previous = ch;
+        
+        if (glyph->src.w > 0 && glyph->src.h > 0) {
+            sprite_batch_draw(batch, atlas->texture, &glyph->src, (float)pen_x, (float)y,
+                              (float)glyph->src.w, (float)glyph->src.h, color);
+        }
+        
+        pen_x += glyph->advance;
+    }
+}
@@ -0,0 +1,189 @@
+#include "log.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+static const char* const level_names[LOG_LEVEL_NONE] = {"DEBUG", "INFO", "Warning", "Error"};
+static const char* const module_names[LOG_MODULE_COUNT] = {
+    "game", "gameplay", "assets", "audio", "render", "replay", "trace"
+};
+
+typedef struct {
+    Uint8 level;
+    Uint8 module;
+    char text[LOG_MESSAGE_MAX];
+} LogEntry;
+
+static struct {
+    Uint8 levels[LOG_MODULE_COUNT];
+    bool levels_set;
+    
+    SDL_Thread* thread;
+    SDL_mutex* lock;
+    SDL_cond* ready;
+    bool quit;
+    LogEntry queue[LOG_QUEUE_SIZE];
+    int head;
+    int count;
+    int dropped;
+    
+    LogEntry batch[LOG_QUEUE_SIZE]; // Writer thread only
+} logger;
+
+static void log_print(const LogEntry* entry) {
+    printf("%s: [%s] %s\n", level_names[entry->level], module_names[entry->module], entry->text);
+}
+
+static int log_parse_level(const char* text, size_t length, LogLevel* level) {
+    static const char* const names[] = {"debug", "info", "warn", "error", "none"};
+    for (int i = 0; i <= LOG_LEVEL_NONE; i++) {
+        if (strlen(names[i]) == length && SDL_strncasecmp(text, names[i], length) == 0) {
+            *level = (LogLevel)i;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+static void log_load_levels(void) {
+    logger.levels_set = true;
+    for (int m = 0; m < LOG_MODULE_COUNT; m++) {
+        logger.levels[m] = LOG_LEVEL_INFO;
+    }
+    
+    // Comma-separated: "level" sets every module, "module=level" one of them
+    const char* spec = SDL_getenv("BRICKOUT_LOG");
+    while (spec && *spec) {
+        size_t length = strcspn(spec, ",");
+        const char* equals = memchr(spec, '=', length);
+        LogLevel level;
+        if (!equals) {
+            if (log_parse_level(spec, length, &level) == 0) {
+                for (int m = 0; m < LOG_MODULE_COUNT; m++) logger.levels[m] = (Uint8)level;
+            }
+        } else if (log_parse_level(equals + 1, length - (size_t)(equals + 1 - spec), &level) == 0) {
+            for (int m = 0; m < LOG_MODULE_COUNT; m++) {
+                size_t name_length = (size_t)(equals - spec);
+                if (strlen(module_names[m]) == name_length &&
+                    strncmp(spec, module_names[m], name_length) == 0) {
+                    logger.levels[m] = (Uint8)level;
+                }
+            }
+        }
+        spec += length;
+        if (*spec == ',') spec++;
+    }
+}
+
+static int log_writer(void* data) {
+    (void)data;
+    SDL_LockMutex(logger.lock);
+    for (;;) {
+        while (logger.count == 0 && logger.dropped == 0 && !logger.quit) {
+            SDL_CondWait(logger.ready, logger.lock);
+        }
+        if (logger.count == 0 && logger.dropped == 0) break; // Quit with nothing left
+        
+        // Take everything queued, then write with the lock released
+        int count = logger.count;
+        for (int i = 0; i < count; i++) {
+            logger.batch[i] = logger.queue[(logger.head + i) % LOG_QUEUE_SIZE];
+        }
+        logger.head = (logger.head + count) % LOG_QUEUE_SIZE;
+        logger.count = 0;
+        int dropped = logger.dropped;
+        logger.dropped = 0;
+        SDL_UnlockMutex(logger.lock);
+        
+        for (int i = 0; i < count; i++) {
+            log_print(&logger.batch[i]);
+        }
+        if (dropped > 0) {
+            printf("Warning: [game] %d log message(s) dropped, the queue was full\n", dropped);
+        }
+        fflush(stdout);
+        
+        SDL_LockMutex(logger.lock);
+    }
+    SDL_UnlockMutex(logger.lock);
+    return 0;
+}
+
+void log_init(void) {
+    if (!logger.levels_set) log_load_levels();
+    if (logger.thread) return;
+    
+    logger.lock = SDL_CreateMutex();
+    logger.ready = SDL_CreateCond();
+    logger.quit = false;
+    if (logger.lock && logger.ready) {
+        logger.thread = SDL_CreateThread(log_writer, "log_writer", NULL);
+    }
+    if (!logger.thread) {
+        // Carry on writing directly
+        if (logger.ready) SDL_DestroyCond(logger.ready);
+        if (logger.lock) SDL_DestroyMutex(logger.lock);
+        logger.ready = NULL;
+        logger.lock = NULL;
+        printf("Warning: [game] No log writer thread, logging synchronously: %s\n", SDL_GetError());
+    }
+}
+
+void log_shutdown(void) {
+    if (!logger.thread) return;
+    
+    // The writer drains the queue before it exits
+    SDL_LockMutex(logger.lock);
+    logger.quit = true;
+    SDL_CondSignal(logger.ready);
+    SDL_UnlockMutex(logger.lock);
+    SDL_WaitThread(logger.thread, NULL);
+    logger.thread = NULL;
+    
+    SDL_DestroyCond(logger.ready);
+    SDL_DestroyMutex(logger.lock);
+    logger.ready = NULL;
+    logger.lock = NULL;
+}
+
+void log_set_level(LogModule module, LogLevel level) {
+    if (!logger.levels_set) log_load_levels();
+    logger.levels[module] = (Uint8)level;
+}
+
+bool log_enabled(LogLevel level, LogModule module) {
+    if (!logger.levels_set) log_load_levels();
+    return level >= (LogLevel)logger.levels[module];
+}
+
+void log_write(LogLevel level, LogModule module, const char* format, ...) {
+    LogEntry entry;
+    entry.level = (Uint8)level;
+    entry.module = (Uint8)module;
+    va_list args;
+    va_start(args, format);
+    vsnprintf(entry.text, sizeof(entry.text), format, args);
+    va_end(args);
+    
+    if (!logger.thread) {
+        log_print(&entry);
+        return;
+    }
+    
+    SDL_LockMutex(logger.lock);
+    bool queued = logger.count < LOG_QUEUE_SIZE;
+    if (queued) {
+        logger.queue[(logger.head + logger.count) % LOG_QUEUE_SIZE] = entry;
+        logger.count++;
+    } else if (level < LOG_LEVEL_WARN) {
+        logger.dropped++;
+    }
+    SDL_CondSignal(logger.ready);
+    SDL_UnlockMutex(logger.lock);
+    
+    // Warnings and errors are never dropped; a full queue means waiting on stdout once
+    if (!queued && level >= LOG_LEVEL_WARN) {
+        log_print(&entry);
+        fflush(stdout);
+    }
+}
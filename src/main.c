@@ -1,25 +1,53 @@
 #include "game.h"
+#include "log.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+static void print_usage(const char* program) {
+    fprintf(stderr, "usage: %s [--autoplay] [--record FILE | --replay FILE]\n", program);
+}
 
 int main(int argc, char* argv[]) {
-    (void)argc; 
-    (void)argv;
+    GameOptions options;
+    memset(&options, 0, sizeof(options));
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--autoplay") == 0) {
+            options.autoplay = true;
+        } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            options.record_path = argv[++i];
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            options.replay_path = argv[++i];
+        } else {
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+    // A replay brings its own input
+    if (options.replay_path && (options.record_path || options.autoplay)) {
+        print_usage(argv[0]);
+        return 2;
+    }
+    
+    // Everything from here on logs through the writer thread
+    log_init();
     
     Game game;
     
-    printf("Initializing Brickout game...\n");
-    if (game_init(&game) != 0) {
-        fprintf(stderr, "Failed to initialize game\n");
+    LOG_INFO(LOG_GAME, "Initializing Brickout game...");
+    if (game_init(&game, &options) != 0) {
+        LOG_ERROR(LOG_GAME, "Failed to initialize game");
+        log_shutdown();
         return 1;
     }
     
-    printf("Game initialized successfully. Starting main loop...\n");
+    LOG_INFO(LOG_GAME, "Game initialized successfully. Starting main loop...");
     game_run(&game);
     
-    printf("Game loop ended. Cleaning up...\n");
+    LOG_INFO(LOG_GAME, "Game loop ended. Cleaning up...");
     game_cleanup(&game);
     
-    printf("Game cleanup complete.\n");
+    LOG_INFO(LOG_GAME, "Game cleanup complete.");
+    log_shutdown();
     return 0;
 }
\ No newline at end of file
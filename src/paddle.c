@@ -1,22 +1,19 @@
 #include "paddle.h"
 #include "game.h"
 
-void paddle_init(Paddle* paddle, float x, float y, SDL_Texture* texture) {
+void paddle_init(Paddle* paddle, float x, float y) {
     paddle->x = x;
     paddle->y = y;
+    paddle->prev_x = x;
+    paddle->prev_y = y;
     paddle->width = 64;
     paddle->height = 16;
     paddle->speed = 300.0f;
-    paddle->texture = texture;
+    paddle->sprite = NULL;
 }
 
-void paddle_update(Paddle* paddle, const Uint8* keyboard_state, float delta_time) {
-    if (keyboard_state[SDL_SCANCODE_LEFT]) {
-        paddle->x -= paddle->speed * delta_time;
-    }
-    if (keyboard_state[SDL_SCANCODE_RIGHT]) {
-        paddle->x += paddle->speed * delta_time;
-    }
+void paddle_update(Paddle* paddle, int direction, float delta_time) {
+    paddle->x += direction * paddle->speed * delta_time;
     
     // Keep paddle within screen bounds
     if (paddle->x < 0) {
@@ -27,12 +24,12 @@ void paddle_update(Paddle* paddle, const Uint8* keyboard_state, float delta_time
     }
 }
 
-void paddle_render(Paddle* paddle, SDL_Renderer* renderer) {
-    if (paddle->texture) {
-        SDL_Rect dest_rect = {
-            (int)paddle->x, (int)paddle->y,
-            paddle->width, paddle->height
-        };
-        SDL_RenderCopy(renderer, paddle->texture, NULL, &dest_rect);
+void paddle_render(Paddle* paddle, SpriteBatch* batch, float alpha) {
+    if (paddle->sprite && paddle->sprite->texture) {
+        // Interpolate between the last two simulation steps
+        float x = paddle->prev_x + (paddle->x - paddle->prev_x) * alpha;
+        float y = paddle->prev_y + (paddle->y - paddle->prev_y) * alpha;
+        SDL_Color white = {255, 255, 255, 255};
+        sprite_batch_draw(batch, paddle->sprite->texture, &paddle->sprite->src, x, y, paddle->width, paddle->height, white);
     }
 }
\ No newline at end of file
@@ -0,0 +1,212 @@
+#include "profiler.h"
+#include "log.h"
+#include "game.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PROFILER_GRAPH_HEIGHT 60
+#define PROFILER_GRAPH_MS (2.0f * 1000.0f / TARGET_FPS) // Full graph height
+#define PROFILER_PANEL_WIDTH (PROFILER_HISTORY + 20)
+#define PROFILER_MARGIN 10
+
+static const char* const phase_names[PROFILE_PHASE_COUNT] = {
+    "events", "update", "render", "present"
+};
+
+// Graph colors per phase, then for the rest of the frame (pacing and vsync waits)
+static const SDL_Color phase_colors[PROFILE_PHASE_COUNT + 1] = {
+    {80, 160, 255, 255},
+    {80, 220, 120, 255},
+    {250, 210, 60, 255},
+    {200, 110, 240, 255},
+    {90, 90, 90, 255}
+};
+
+void profiler_init(Profiler* profiler) {
+    memset(profiler, 0, sizeof(*profiler));
+    profiler->frequency = SDL_GetPerformanceFrequency();
+    
+    // BRICKOUT_PROFILER=1 shows the overlay from the first frame, for field units
+    const char* visible = SDL_getenv("BRICKOUT_PROFILER");
+    profiler->visible = visible && *visible && *visible != '0';
+}
+
+static int profiler_compare_ms(const void* a, const void* b) {
+    float x = *(const float*)a;
+    float y = *(const float*)b;
+    return (x > y) - (x < y);
+}
+
+static void profiler_update_stats(Profiler* profiler) {
+    int count = profiler->count;
+    if (count == 0) return;
+    
+    float sorted[PROFILER_HISTORY];
+    memcpy(sorted, profiler->frame_ms, sizeof(float) * count);
+    qsort(sorted, count, sizeof(float), profiler_compare_ms);
+    profiler->p50 = sorted[(count - 1) / 2];
+    profiler->p99 = sorted[(count - 1) * 99 / 100];
+    profiler->max = sorted[count - 1];
+    
+    for (int phase = 0; phase < PROFILE_PHASE_COUNT; phase++) {
+        float total = 0.0f;
+        float max = 0.0f;
+        for (int i = 0; i < count; i++) {
+            float ms = profiler->phase_ms[phase][i];
+            total += ms;
+            if (ms > max) max = ms;
+        }
+        profiler->phase_avg[phase] = total / count;
+        profiler->phase_max[phase] = max;
+    }
+    profiler->frames_since_stats = 0;
+}
+
+void profiler_cleanup(Profiler* profiler) {
+    if (profiler->count > 0) {
+        profiler_update_stats(profiler);
+        LOG_INFO(LOG_RENDER, "Frame time over the last %d frames: p50 %.2f ms, p99 %.2f ms, max %.2f ms; "
+                 "%u of %u frames over %.1f ms", profiler->count, profiler->p50, profiler->p99,
+                 profiler->max, profiler->spikes, profiler->frames, PROFILER_SPIKE_MS);
+    }
+    glyph_atlas_cleanup(&profiler->glyphs);
+    if (profiler->font) {
+        TTF_CloseFont(profiler->font);
+        profiler->font = NULL;
+    }
+}
+
+void profiler_toggle(Profiler* profiler) {
+    profiler->visible = !profiler->visible;
+    profiler->frames_since_stats = PROFILER_STATS_INTERVAL; // Fresh figures on the next frame
+}
+
+static float profiler_ms(const Profiler* profiler, Uint64 ticks) {
+    return (float)((double)ticks * 1000.0 / (double)profiler->frequency);
+}
+
+void profiler_begin_frame(Profiler* profiler) {
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (profiler->frame_start != 0) {
+        // Close out the previous frame
+        float frame_ms = profiler_ms(profiler, now - profiler->frame_start);
+        int slot = profiler->head;
+        profiler->frame_ms[slot] = frame_ms;
+        for (int phase = 0; phase < PROFILE_PHASE_COUNT; phase++) {
+            profiler->phase_ms[phase][slot] = profiler->phase_current[phase];
+        }
+        profiler->head = (slot + 1) % PROFILER_HISTORY;
+        if (profiler->count < PROFILER_HISTORY) profiler->count++;
+        
+        profiler->frames++;
+        if (frame_ms > PROFILER_SPIKE_MS) profiler->spikes++;
+        profiler->frames_since_stats++;
+    }
+    profiler->frame_start = now;
+    memset(profiler->phase_current, 0, sizeof(profiler->phase_current));
+}
+
+void profiler_begin(Profiler* profiler, ProfilePhase phase) {
+    profiler->phase_start[phase] = SDL_GetPerformanceCounter();
+}
+
+void profiler_end(Profiler* profiler, ProfilePhase phase) {
+    Uint64 elapsed = SDL_GetPerformanceCounter() - profiler->phase_start[phase];
+    profiler->phase_current[phase] += profiler_ms(profiler, elapsed);
+}
+
+static void profiler_render_graph(Profiler* profiler, SDL_Renderer* renderer, int x, int bottom) {
+    SDL_Rect rects[PROFILE_PHASE_COUNT + 1][PROFILER_HISTORY];
+    int rect_counts[PROFILE_PHASE_COUNT + 1] = {0};
+    float px_per_ms = PROFILER_GRAPH_HEIGHT / PROFILER_GRAPH_MS;
+    
+    // One column per frame, oldest on the left, phases stacked from the bottom
+    int first = (profiler->head - profiler->count + PROFILER_HISTORY) % PROFILER_HISTORY;
+    for (int i = 0; i < profiler->count; i++) {
+        int slot = (first + i) % PROFILER_HISTORY;
+        int column = x + PROFILER_HISTORY - profiler->count + i;
+        float stacked_ms = 0.0f;
+        for (int segment = 0; segment <= PROFILE_PHASE_COUNT; segment++) {
+            float ms = segment < PROFILE_PHASE_COUNT ? profiler->phase_ms[segment][slot]
+                                                     : profiler->frame_ms[slot] - stacked_ms;
+            int y0 = (int)(stacked_ms * px_per_ms);
+            stacked_ms += ms;
+            int y1 = (int)(stacked_ms * px_per_ms);
+            if (y1 > PROFILER_GRAPH_HEIGHT) y1 = PROFILER_GRAPH_HEIGHT;
+            if (y1 <= y0) continue;
+            SDL_Rect rect = {column, bottom - y1, 1, y1 - y0};
+            rects[segment][rect_counts[segment]++] = rect;
+        }
+    }
+    
+    for (int segment = 0; segment <= PROFILE_PHASE_COUNT; segment++) {
+        if (rect_counts[segment] == 0) continue;
+        SDL_Color c = phase_colors[segment];
+        SDL_SetRenderDrawColor(renderer, c.r, c.g, c.b, c.a);
+        SDL_RenderFillRects(renderer, rects[segment], rect_counts[segment]);
+    }
+    
+    // Frame budget line
+    int budget_y = bottom - (int)(1000.0f / TARGET_FPS * px_per_ms);
+    SDL_SetRenderDrawColor(renderer, 255, 80, 80, 255);
+    SDL_RenderDrawLine(renderer, x, budget_y, x + PROFILER_HISTORY - 1, budget_y);
+}
+
+void profiler_render(Profiler* profiler, TextureManager* tm) {
+    if (!profiler->visible) return;
+    
+    if (!profiler->glyphs.texture && !profiler->font_failed) {
+        profiler->font = TTF_OpenFont(PROFILER_FONT, PROFILER_FONT_SIZE);
+        if (!profiler->font || glyph_atlas_init(&profiler->glyphs, tm->renderer, profiler->font) != 0) {
+            LOG_WARN(LOG_RENDER, "Profiler overlay has no font, showing the graph only: %s", TTF_GetError());
+            profiler->font_failed = true;
+        }
+    }
+    if (profiler->frames_since_stats >= PROFILER_STATS_INTERVAL) {
+        profiler_update_stats(profiler);
+    }
+    
+    int line_height = profiler->glyphs.texture ? profiler->glyphs.line_height : 0;
+    int text_lines = 2 + PROFILE_PHASE_COUNT;
+    int panel_height = PROFILER_GRAPH_HEIGHT + 20 + text_lines * line_height;
+    int panel_x = PROFILER_MARGIN;
+    int panel_y = WINDOW_HEIGHT - panel_height - PROFILER_MARGIN;
+    
+    // The screen's sprites go down first so the panel covers them
+    SpriteBatch* batch = &tm->sprites;
+    SDL_Renderer* renderer = tm->renderer;
+    sprite_batch_flush(batch);
+    SpriteBatchStats draws = batch->frame;
+    
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 192);
+    SDL_Rect panel = {panel_x, panel_y, PROFILER_PANEL_WIDTH, panel_height};
+    SDL_RenderFillRect(renderer, &panel);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    
+    int graph_bottom = panel_y + 10 + PROFILER_GRAPH_HEIGHT;
+    profiler_render_graph(profiler, renderer, panel_x + 10, graph_bottom);
+    if (!profiler->glyphs.texture) return;
+    
+    SDL_Color white = {255, 255, 255, 255};
+    char line[96];
+    int text_x = panel_x + 10;
+    int text_y = graph_bottom + 5;
+    snprintf(line, sizeof(line), "frame  p50 %.1f  p99 %.1f  max %.1f ms",
+             profiler->p50, profiler->p99, profiler->max);
+    glyph_atlas_draw(&profiler->glyphs, batch, line, text_x, text_y, white);
+    text_y += line_height;
+    
+    for (int phase = 0; phase < PROFILE_PHASE_COUNT; phase++) {
+        snprintf(line, sizeof(line), "%s  avg %.2f  max %.2f ms", phase_names[phase],
+                 profiler->phase_avg[phase], profiler->phase_max[phase]);
+        glyph_atlas_draw(&profiler->glyphs, batch, line, text_x, text_y, phase_colors[phase]);
+        text_y += line_height;
+    }
+    
+    // Sprite batch figures for the screen underneath, before the panel's own
+    snprintf(line, sizeof(line), "%d draws, %d sprites, %u spikes",
+             draws.draw_calls, draws.sprites, profiler->spikes);
+    glyph_atlas_draw(&profiler->glyphs, batch, line, text_x, text_y, white);
+}
@@ -0,0 +1,163 @@
+#include "replay.h"
+#include "log.h"
+#include "game.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define REPLAY_INITIAL_CAPACITY (SIMULATION_HZ * 60)
+
+// Bits 0-1 are the held keys, the rest GAMEPLAY_COMMAND_* shifted up
+static Uint8 replay_pack(const GameplayInput* input) {
+    return (Uint8)((input->left ? 1 : 0) | (input->right ? 2 : 0) | (input->commands << 2));
+}
+
+static void replay_unpack(Uint8 packed, GameplayInput* input) {
+    input->left = (packed & 1) != 0;
+    input->right = (packed & 2) != 0;
+    input->commands = packed >> 2;
+}
+
+void replay_begin(Replay* replay, Uint32 seed) {
+    replay->seed = seed;
+    replay->end_hash = 0;
+    replay->tick_count = 0;
+}
+
+void replay_record(Replay* replay, const GameplayInput* input) {
+    if (replay->tick_count == replay->capacity) {
+        int capacity = replay->capacity ? replay->capacity * 2 : REPLAY_INITIAL_CAPACITY;
+        Uint8* ticks = realloc(replay->ticks, (size_t)capacity);
+        if (!ticks) {
+            LOG_WARN(LOG_REPLAY, "Out of memory recording replay, input dropped");
+            return;
+        }
+        replay->ticks = ticks;
+        replay->capacity = capacity;
+    }
+    replay->ticks[replay->tick_count++] = replay_pack(input);
+}
+
+void replay_free(Replay* replay) {
+    free(replay->ticks);
+    memset(replay, 0, sizeof(*replay));
+}
+
+bool replay_input(const Replay* replay, int tick, GameplayInput* input) {
+    if (tick < 0 || tick >= replay->tick_count) return false;
+    replay_unpack(replay->ticks[tick], input);
+    return true;
+}
+
+bool replay_save(Replay* replay, const char* path, Uint32 end_hash) {
+    replay->end_hash = end_hash;
+    
+    // Held keys change a few times a second at most, so runs are long:
+    // each is the packed input followed by its length - 1 as a varint
+    Uint8* payload = malloc((size_t)replay->tick_count * 6 + 1);
+    if (!payload) return false;
+    size_t size = 0;
+    for (int i = 0; i < replay->tick_count;) {
+        int run = 1;
+        while (i + run < replay->tick_count && replay->ticks[i + run] == replay->ticks[i]) {
+            run++;
+        }
+        payload[size++] = replay->ticks[i];
+        Uint32 extra = (Uint32)(run - 1);
+        do {
+            Uint8 byte = extra & 0x7f;
+            extra >>= 7;
+            payload[size++] = byte | (extra ? 0x80 : 0);
+        } while (extra);
+        i += run;
+    }
+    
+    ReplayHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = REPLAY_MAGIC;
+    header.version = REPLAY_VERSION;
+    header.simulation_hz = SIMULATION_HZ;
+    header.seed = replay->seed;
+    header.tick_count = (Uint32)replay->tick_count;
+    header.end_hash = end_hash;
+    header.payload_size = (Uint32)size;
+    
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        LOG_WARN(LOG_REPLAY, "Unable to write replay %s", path);
+        free(payload);
+        return false;
+    }
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                   fwrite(payload, 1, size, file) == size;
+    written = fclose(file) == 0 && written;
+    free(payload);
+    if (!written) {
+        LOG_WARN(LOG_REPLAY, "Unable to write replay %s", path);
+        return false;
+    }
+    LOG_INFO(LOG_REPLAY, "Saved replay %s: %d ticks, %zu bytes of input", path, replay->tick_count, size);
+    return true;
+}
+
+bool replay_load(Replay* replay, const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        LOG_WARN(LOG_REPLAY, "Unable to open replay %s", path);
+        return false;
+    }
+    
+    ReplayHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 ||
+        header.magic != REPLAY_MAGIC || header.version != REPLAY_VERSION) {
+        LOG_WARN(LOG_REPLAY, "%s is not a replay", path);
+        fclose(file);
+        return false;
+    }
+    if (header.simulation_hz != SIMULATION_HZ) {
+        LOG_WARN(LOG_REPLAY, "Replay %s was recorded at %u Hz, the simulation runs at %d Hz",
+                 path, (unsigned)header.simulation_hz, SIMULATION_HZ);
+        fclose(file);
+        return false;
+    }
+    
+    Uint8* payload = malloc(header.payload_size ? header.payload_size : 1);
+    Uint8* ticks = malloc(header.tick_count ? header.tick_count : 1);
+    bool ok = payload && ticks && fread(payload, 1, header.payload_size, file) == header.payload_size;
+    fclose(file);
+    
+    // Expand the runs, refusing any that overflow the tick count
+    Uint32 tick = 0;
+    size_t offset = 0;
+    while (ok && offset < header.payload_size) {
+        Uint8 packed = payload[offset++];
+        Uint32 extra = 0;
+        int shift = 0;
+        Uint8 byte;
+        do {
+            ok = offset < header.payload_size && shift < 32;
+            if (!ok) break;
+            byte = payload[offset++];
+            extra |= (Uint32)(byte & 0x7f) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+        ok = ok && extra < header.tick_count - tick;
+        if (!ok) break;
+        memset(ticks + tick, packed, extra + 1);
+        tick += extra + 1;
+    }
+    free(payload);
+    if (!ok || tick != header.tick_count) {
+        LOG_WARN(LOG_REPLAY, "Replay %s is damaged", path);
+        free(ticks);
+        return false;
+    }
+    
+    replay_free(replay);
+    replay->seed = header.seed;
+    replay->end_hash = header.end_hash;
+    replay->ticks = ticks;
+    replay->tick_count = (int)header.tick_count;
+    replay->capacity = (int)header.tick_count;
+    return true;
+}
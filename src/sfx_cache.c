@@ -0,0 +1,154 @@
+#include "sfx_cache.h"
+#include "log.h"
+#include <stdio.h>
+#include <string.h>
+
+static Uint64 sfx_cache_hash(const Uint8* data, size_t size) {
+    // 64-bit FNV-1a
+    Uint64 hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static Uint32 sfx_cache_elapsed_us(Uint64 start) {
+    return (Uint32)((SDL_GetPerformanceCounter() - start) * 1000000 / SDL_GetPerformanceFrequency());
+}
+
+void sfx_cache_init(SfxCache* cache) {
+    memset(cache, 0, sizeof(*cache));
+    
+    // BRICKOUT_NO_SFX_CACHE=1 decodes every start, for comparing load times
+    const char* disabled = SDL_getenv("BRICKOUT_NO_SFX_CACHE");
+    if (disabled && *disabled && *disabled != '0') {
+        LOG_INFO(LOG_ASSETS, "SFX cache disabled");
+        return;
+    }
+    if (!Mix_QuerySpec(&cache->frequency, &cache->format, &cache->channels)) {
+        return; // No audio, nothing to convert for
+    }
+    
+    char* pref_path = SDL_GetPrefPath(SFX_CACHE_ORG, SFX_CACHE_APP);
+    if (!pref_path) {
+        LOG_WARN(LOG_ASSETS, "No writable directory for the SFX cache: %s", SDL_GetError());
+        return;
+    }
+    if (strlen(pref_path) < sizeof(cache->dir) - 64) {
+        strcpy(cache->dir, pref_path);
+        cache->enabled = true;
+    }
+    SDL_free(pref_path);
+}
+
+void sfx_cache_report(const SfxCache* cache) {
+    SfxCache* counters = (SfxCache*)cache; // SDL_AtomicGet takes a non-const pointer
+    int hits = SDL_AtomicGet(&counters->hits);
+    int misses = SDL_AtomicGet(&counters->misses);
+    if (hits + misses == 0) return;
+    
+    LOG_INFO(LOG_ASSETS, "SFX loading: %d from cache in %.2f ms, %d decoded in %.2f ms",
+             hits, SDL_AtomicGet(&counters->hit_us) / 1000.0,
+             misses, SDL_AtomicGet(&counters->miss_us) / 1000.0);
+}
+
+static void sfx_cache_file_path(const SfxCache* cache, Uint64 hash, char* path, size_t size) {
+    snprintf(path, size, "%ssfx-%016llx-%d-%04x-%d.pcm", cache->dir, (unsigned long long)hash,
+             cache->frequency, (unsigned)cache->format, cache->channels);
+}
+
+static Mix_Chunk* sfx_cache_read(const SfxCache* cache, const char* path, Uint64 hash) {
+    SDL_RWops* file = SDL_RWFromFile(path, "rb");
+    if (!file) return NULL;
+    
+    SfxCacheHeader header;
+    Uint8* samples = NULL;
+    if (SDL_RWread(file, &header, sizeof(header), 1) == 1 &&
+        header.magic == SFX_CACHE_MAGIC && header.version == SFX_CACHE_VERSION &&
+        header.source_hash == hash && (int)header.frequency == cache->frequency &&
+        header.format == cache->format && (int)header.channels == cache->channels &&
+        header.size > 0) {
+        samples = SDL_malloc(header.size);
+        if (samples && SDL_RWread(file, samples, 1, header.size) != header.size) {
+            SDL_free(samples);
+            samples = NULL;
+        }
+    }
+    SDL_RWclose(file);
+    if (!samples) return NULL;
+    
+    Mix_Chunk* chunk = Mix_QuickLoad_RAW(samples, header.size);
+    if (!chunk) {
+        SDL_free(samples);
+        return NULL;
+    }
+    // Hand the samples to the chunk so Mix_FreeChunk releases them
+    chunk->allocated = 1;
+    return chunk;
+}
+
+static void sfx_cache_write(const SfxCache* cache, const char* path, Uint64 hash, const Mix_Chunk* chunk) {
+    SfxCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = SFX_CACHE_MAGIC;
+    header.version = SFX_CACHE_VERSION;
+    header.source_hash = hash;
+    header.frequency = (Uint32)cache->frequency;
+    header.format = cache->format;
+    header.channels = (Uint16)cache->channels;
+    header.size = chunk->alen;
+    
+    // Written aside and renamed, so a crash never leaves a torn entry behind
+    char temp_path[SFX_CACHE_PATH_MAX + 8];
+    snprintf(temp_path, sizeof(temp_path), "%s.tmp", path);
+    FILE* file = fopen(temp_path, "wb");
+    if (!file) {
+        LOG_WARN(LOG_ASSETS, "Unable to write SFX cache %s", temp_path);
+        return;
+    }
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                   fwrite(chunk->abuf, 1, chunk->alen, file) == chunk->alen;
+    written = fclose(file) == 0 && written;
+    if (!written || rename(temp_path, path) != 0) {
+        LOG_WARN(LOG_ASSETS, "Unable to write SFX cache %s", path);
+        remove(temp_path);
+    }
+}
+
+Mix_Chunk* sfx_cache_load(SfxCache* cache, const char* path) {
+    Uint64 start = SDL_GetPerformanceCounter();
+    if (!cache->enabled) {
+        Mix_Chunk* chunk = Mix_LoadWAV(path);
+        SDL_AtomicAdd(&cache->misses, 1);
+        SDL_AtomicAdd(&cache->miss_us, (int)sfx_cache_elapsed_us(start));
+        return chunk;
+    }
+    
+    // The source is small and needed for the key anyway, so read it whole
+    size_t source_size = 0;
+    void* source = SDL_LoadFile(path, &source_size);
+    if (!source) return NULL;
+    
+    Uint64 hash = sfx_cache_hash(source, source_size);
+    char cache_path[SFX_CACHE_PATH_MAX];
+    sfx_cache_file_path(cache, hash, cache_path, sizeof(cache_path));
+    
+    Mix_Chunk* chunk = sfx_cache_read(cache, cache_path, hash);
+    if (chunk) {
+        SDL_free(source);
+        SDL_AtomicAdd(&cache->hits, 1);
+        SDL_AtomicAdd(&cache->hit_us, (int)sfx_cache_elapsed_us(start));
+        return chunk;
+    }
+    
+    // Decode from the bytes already in memory, then keep the result
+    chunk = Mix_LoadWAV_RW(SDL_RWFromConstMem(source, (int)source_size), 1);
+    SDL_free(source);
+    if (chunk) {
+        sfx_cache_write(cache, cache_path, hash, chunk);
+    }
+    SDL_AtomicAdd(&cache->misses, 1);
+    SDL_AtomicAdd(&cache->miss_us, (int)sfx_cache_elapsed_us(start));
+    return chunk;
+}
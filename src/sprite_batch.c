@@ -0,0 +1,118 @@
+#include "sprite_batch.h"
+#include "log.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+int sprite_batch_init(SpriteBatch* batch, SDL_Renderer* renderer) {
+    batch->renderer = renderer;
+    batch->texture = NULL;
+    batch->inv_texture_width = 1.0f;
+    batch->inv_texture_height = 1.0f;
+    batch->sprite_count = 0;
+    batch->frames = 0;
+    SDL_zero(batch->frame);
+    SDL_zero(batch->last_frame);
+    SDL_zero(batch->total);
+    
+    batch->vertices = malloc(SPRITE_BATCH_CAPACITY * 4 * sizeof(SDL_Vertex));
+    batch->indices = malloc(SPRITE_BATCH_CAPACITY * 6 * sizeof(int));
+    if (!batch->vertices || !batch->indices) {
+        LOG_ERROR(LOG_RENDER, "Unable to allocate sprite batch buffers");
+        sprite_batch_cleanup(batch);
+        return -1;
+    }
+    
+    // Every quad uses the same two triangles, so the index buffer is fixed
+    for (int i = 0; i < SPRITE_BATCH_CAPACITY; i++) {
+        int* idx = &batch->indices[i * 6];
+        int base = i * 4;
+        idx[0] = base; idx[1] = base + 1; idx[2] = base + 2;
+        idx[3] = base; idx[4] = base + 2; idx[5] = base + 3;
+    }
+    
+    return 0;
+}
+
+void sprite_batch_cleanup(SpriteBatch* batch) {
+    free(batch->vertices);
+    free(batch->indices);
+    batch->vertices = NULL;
+    batch->indices = NULL;
+    batch->sprite_count = 0;
+}
+
+void sprite_batch_begin_frame(SpriteBatch* batch) {
+    sprite_batch_flush(batch);
+    
+    batch->last_frame = batch->frame;
+    batch->total.draw_calls += batch->frame.draw_calls;
+    batch->total.vertices += batch->frame.vertices;
+    batch->total.sprites += batch->frame.sprites;
+    batch->frames++;
+    SDL_zero(batch->frame);
+}
+
+void sprite_batch_draw(SpriteBatch* batch, SDL_Texture* texture, const SDL_Rect* src,
+                       float x, float y, float width, float height, SDL_Color color) {
+    if (!texture) return;
+    
+    // Without buffers fall back to a plain copy, tinted through the texture
+    if (!batch->vertices) {
+        Uint8 r, g, b, a;
+        SDL_GetTextureColorMod(texture, &r, &g, &b);
+        SDL_GetTextureAlphaMod(texture, &a);
+        SDL_SetTextureColorMod(texture, color.r, color.g, color.b);
+        SDL_SetTextureAlphaMod(texture, color.a);
+        SDL_Rect dest_rect = {(int)x, (int)y, (int)width, (int)height};
+        SDL_RenderCopy(batch->renderer, texture, src, &dest_rect);
+        SDL_SetTextureColorMod(texture, r, g, b);
+        SDL_SetTextureAlphaMod(texture, a);
+        return;
+    }
+    
+    if (texture != batch->texture || batch->sprite_count == SPRITE_BATCH_CAPACITY) {
+        sprite_batch_flush(batch);
+        if (texture != batch->texture) {
+            int texture_width = 1, texture_height = 1;
+            SDL_QueryTexture(texture, NULL, NULL, &texture_width, &texture_height);
+            batch->texture = texture;
+            batch->inv_texture_width = 1.0f / (texture_width > 0 ? texture_width : 1);
+            batch->inv_texture_height = 1.0f / (texture_height > 0 ? texture_height : 1);
+        }
+    }
+    
+    float u0 = 0.0f, v0 = 0.0f, u1 = 1.0f, v1 = 1.0f;
+    if (src) {
+        u0 = src->x * batch->inv_texture_width;
+        v0 = src->y * batch->inv_texture_height;
+        u1 = (src->x + src->w) * batch->inv_texture_width;
+        v1 = (src->y + src->h) * batch->inv_texture_height;
+    }
+    
+    SDL_Vertex* v = &batch->vertices[batch->sprite_count * 4];
+    v[0].position.x = x;         v[0].position.y = y;          v[0].tex_coord.x = u0; v[0].tex_coord.y = v0;
+    v[1].position.x = x + width; v[1].position.y = y;          v[1].tex_coord.x = u1; v[1].tex_coord.y = v0;
+    v[2].position.x = x + width; v[2].position.y = y + height; v[2].tex_coord.x = u1; v[2].tex_coord.y = v1;
+    v[3].position.x = x;         v[3].position.y = y + height; v[3].tex_coord.x = u0; v[3].tex_coord.y = v1;
+    for (int i = 0; i < 4; i++) {
+        v[i].color = color;
+    }
+    
+    batch->sprite_count++;
+}
+
+void sprite_batch_flush(SpriteBatch* batch) {
+    if (batch->sprite_count == 0) return;
+    
+    SDL_RenderGeometry(batch->renderer, batch->texture, batch->vertices, batch->sprite_count * 4,
+                       batch->indices, batch->sprite_count * 6);
+    
+    batch->frame.draw_calls++;
+    batch->frame.vertices += batch->sprite_count * 4;
+    batch->frame.sprites += batch->sprite_count;
+    batch->sprite_count = 0;
+    
+    // Textures are destroyed and recreated at runtime, and a new one can
+    // reuse a freed one's address with another size; query it again
+    batch->texture = NULL;
+}
@@ -1,16 +1,21 @@
 #include "texture_manager.h"
+#include "log.h"
+#include "trace.h"
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
 
 SDL_Texture* load_texture(SDL_Renderer* renderer, const char* path, int* width, int* height) {
     SDL_Surface* surface = IMG_Load(path);
     if (!surface) {
-        printf("Unable to load image %s! SDL_image Error: %s\n", path, IMG_GetError());
+        LOG_ERROR(LOG_ASSETS, "Unable to load image %s! SDL_image Error: %s", path, IMG_GetError());
         return NULL;
     }
     
     SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
     if (!texture) {
-        printf("Unable to create texture from %s! SDL Error: %s\n", path, SDL_GetError());
+        LOG_ERROR(LOG_ASSETS, "Unable to create texture from %s! SDL Error: %s", path, SDL_GetError());
     } else {
         if (width) *width = surface->w;
         if (height) *height = surface->h;
@@ -21,259 +26,77 @@ SDL_Texture* load_texture(SDL_Renderer* renderer, const char* path, int* width,
 }
 
 int texture_manager_init(TextureManager* tm, SDL_Renderer* renderer) {
-    printf("DEBUG: Starting texture manager init...\n");
+    TRACE_SCOPE("texture_manager_init");
+    LOG_DEBUG(LOG_ASSETS, "Starting texture manager init...");
     tm->renderer = renderer;
     
-    // Initialize all textures to NULL first
-    tm->background.texture = NULL;
-    tm->logo.texture = NULL;
-    tm->dashie.texture = NULL;
-    tm->kion_ded.texture = NULL;
-    tm->kion_happi.texture = NULL;
-    tm->arrow.texture = NULL;
-    tm->ball.texture = NULL;
-    tm->paddle.texture = NULL;
-    tm->brick_red.texture = NULL;
-    tm->brick_yellow.texture = NULL;
-    tm->brick_green.texture = NULL;
-    tm->brick_blue.texture = NULL;
-    tm->brick_purple.texture = NULL;
-    tm->font_regular = NULL;
-    tm->font_title = NULL;
-    
-    // Initialize audio to NULL
-    tm->bgm_title = NULL;
-    tm->bgm_stage1 = NULL;
-    tm->bgm_stage2 = NULL;
-    tm->bgm_stage3 = NULL;
-    tm->bgm_stage4 = NULL;
-    tm->bgm_stage5 = NULL;
-    tm->bgm_gameover = NULL;
-    tm->bgm_complete = NULL;
-    tm->sfx_ball_paddle = NULL;
-    tm->sfx_ball_wall = NULL;
-    tm->sfx_ball_brick = NULL;
-    tm->sfx_brick_break = NULL;
-    tm->sfx_lose_life = NULL;
-    tm->sfx_menu_select = NULL;
-    
-    printf("DEBUG: Loading background texture...\n");
-    tm->background.texture = load_texture(renderer, "docs/img/background-bits.png", 
-                                        &tm->background.width, &tm->background.height);
-    if (!tm->background.texture) {
-        printf("Warning: Failed to load background texture\n");
-        // Don't return error, continue with other textures
-    } else {
-        printf("DEBUG: Background texture loaded successfully\n");
-    }
-    
-    tm->logo.texture = load_texture(renderer, "docs/img/brickout-logo.webp", 
-                                   &tm->logo.width, &tm->logo.height);
-    if (!tm->logo.texture) {
-        printf("Warning: Failed to load logo texture\n");
-    }
-    
-    tm->dashie.texture = load_texture(renderer, "docs/img/dashie.webp", 
-                                     &tm->dashie.width, &tm->dashie.height);
-    if (!tm->dashie.texture) {
-        printf("Warning: Failed to load dashie texture\n");
-    }
-    
-    tm->kion_ded.texture = load_texture(renderer, "docs/img/kion-ded.webp", 
-                                       &tm->kion_ded.width, &tm->kion_ded.height);
-    if (!tm->kion_ded.texture) {
-        printf("Warning: Failed to load kion-ded texture\n");
+    if (sprite_batch_init(&tm->sprites, renderer) != 0) {
+        LOG_WARN(LOG_ASSETS, "Sprite batch unavailable, drawing sprites individually");
     }
     
-    tm->kion_happi.texture = load_texture(renderer, "docs/img/kion-happi.webp", 
-                                         &tm->kion_happi.width, &tm->kion_happi.height);
-    if (!tm->kion_happi.texture) {
-        printf("Warning: Failed to load kion-happi texture\n");
-    }
-    
-    tm->arrow.texture = load_texture(renderer, "docs/assets/UI/arrow_decorative_green.png", 
-                                    &tm->arrow.width, &tm->arrow.height);
-    if (!tm->arrow.texture) {
-        printf("Warning: Failed to load arrow texture\n");
-    }
-    
-    printf("DEBUG: Loading gameplay textures...\n");
-    tm->ball.texture = load_texture(renderer, "docs/assets/UI/ballBlue.png", 
-                                   &tm->ball.width, &tm->ball.height);
-    if (!tm->ball.texture) {
-        printf("Warning: Failed to load ball texture\n");
-    }
-    
-    tm->paddle.texture = load_texture(renderer, "docs/assets/UI/paddleBlu.png", 
-                                     &tm->paddle.width, &tm->paddle.height);
-    if (!tm->paddle.texture) {
-        printf("Warning: Failed to load paddle texture\n");
-    }
+    tm->font_regular = NULL;
+    tm->font_title = NULL;
+    memset(&tm->glyphs_regular, 0, sizeof(tm->glyphs_regular));
+    memset(&tm->glyphs_title, 0, sizeof(tm->glyphs_title));
     
-    tm->brick_red.texture = load_texture(renderer, "docs/assets/UI/element_red_rectangle.png", 
-                                        &tm->brick_red.width, &tm->brick_red.height);
-    tm->brick_yellow.texture = load_texture(renderer, "docs/assets/UI/element_yellow_rectangle.png", 
-                                           &tm->brick_yellow.width, &tm->brick_yellow.height);
-    tm->brick_green.texture = load_texture(renderer, "docs/assets/UI/element_green_rectangle.png", 
-                                          &tm->brick_green.width, &tm->brick_green.height);
-    tm->brick_blue.texture = load_texture(renderer, "docs/assets/UI/element_blue_rectangle.png", 
-                                         &tm->brick_blue.width, &tm->brick_blue.height);
-    tm->brick_purple.texture = load_texture(renderer, "docs/assets/UI/element_purple_rectangle.png", 
-                                           &tm->brick_purple.width, &tm->brick_purple.height);
+    memset(&tm->text_cache, 0, sizeof(tm->text_cache));
     
-    printf("Loading fonts...\n");
+    LOG_INFO(LOG_ASSETS, "Loading fonts...");
     tm->font_regular = TTF_OpenFont("docs/assets/Font/Kenney Future.ttf", 24);
     if (!tm->font_regular) {
-        printf("Warning: Failed to load regular font: %s\n", TTF_GetError());
+        LOG_WARN(LOG_ASSETS, "Failed to load regular font: %s", TTF_GetError());
         // Try alternative path
         tm->font_regular = TTF_OpenFont("docs/assets/Font/Kenney Future Narrow.ttf", 24);
         if (!tm->font_regular) {
-            printf("Warning: Failed to load narrow font: %s\n", TTF_GetError());
+            LOG_WARN(LOG_ASSETS, "Failed to load narrow font: %s", TTF_GetError());
         } else {
-            printf("Loaded narrow font successfully\n");
+            LOG_INFO(LOG_ASSETS, "Loaded narrow font successfully");
         }
     } else {
-        printf("Loaded regular font successfully\n");
+        LOG_INFO(LOG_ASSETS, "Loaded regular font successfully");
     }
     
     tm->font_title = TTF_OpenFont("docs/assets/Font/Kenney Future.ttf", 32);
     if (!tm->font_title) {
-        printf("Warning: Failed to load title font: %s\n", TTF_GetError());
+        LOG_WARN(LOG_ASSETS, "Failed to load title font: %s", TTF_GetError());
     }
     
-    // Load BGM tracks
-    printf("DEBUG: Loading BGM tracks...\n");
-    tm->bgm_title = Mix_LoadMUS("docs/assets/BGM/Title Screen.wav");
-    if (!tm->bgm_title) {
-        printf("Warning: Failed to load title BGM: %s\n", Mix_GetError());
+    LOG_DEBUG(LOG_ASSETS, "Building glyph atlases...");
+    if (tm->font_regular && glyph_atlas_init(&tm->glyphs_regular, renderer, tm->font_regular) != 0) {
+        LOG_WARN(LOG_ASSETS, "Failed to build regular glyph atlas, using text cache");
     }
-    
-    tm->bgm_stage1 = Mix_LoadMUS("docs/assets/BGM/Stage_1.wav");
-    if (!tm->bgm_stage1) {
-        printf("Warning: Failed to load stage 1 BGM: %s\n", Mix_GetError());
-    }
-    
-    tm->bgm_stage2 = Mix_LoadMUS("docs/assets/BGM/Stage_2.wav");
-    if (!tm->bgm_stage2) {
-        printf("Warning: Failed to load stage 2 BGM: %s\n", Mix_GetError());
-    }
-    
-    tm->bgm_stage3 = Mix_LoadMUS("docs/assets/BGM/Stage_3.wav");
-    if (!tm->bgm_stage3) {
-        printf("Warning: Failed to load stage 3 BGM: %s\n", Mix_GetError());
-    }
-    
-    tm->bgm_stage4 = Mix_LoadMUS("docs/assets/BGM/Stage_4.wav");
-    if (!tm->bgm_stage4) {
-        printf("Warning: Failed to load stage 4 BGM: %s\n", Mix_GetError());
-    }
-    
-    tm->bgm_stage5 = Mix_LoadMUS("docs/assets/BGM/Stage_5.wav");
-    if (!tm->bgm_stage5) {
-        printf("Warning: Failed to load stage 5 BGM: %s\n", Mix_GetError());
-    }
-    
-    tm->bgm_gameover = Mix_LoadMUS("docs/assets/BGM/GameOver.wav");
-    if (!tm->bgm_gameover) {
-        printf("Warning: Failed to load game over BGM: %s\n", Mix_GetError());
-    }
-    
-    tm->bgm_complete = Mix_LoadMUS("docs/assets/BGM/GameComplete.wav");
-    if (!tm->bgm_complete) {
-        printf("Warning: Failed to load game complete BGM: %s\n", Mix_GetError());
-    }
-    
-    // Load SFX
-    printf("DEBUG: Loading SFX...\n");
-    tm->sfx_ball_paddle = Mix_LoadWAV("docs/assets/SFX/ball_hit_paddle.mp3");
-    if (!tm->sfx_ball_paddle) {
-        printf("Warning: Failed to load ball paddle SFX: %s\n", Mix_GetError());
-    }
-    
-    tm->sfx_ball_wall = Mix_LoadWAV("docs/assets/SFX/ball_hit_wall.mp3");
-    if (!tm->sfx_ball_wall) {
-        printf("Warning: Failed to load ball wall SFX: %s\n", Mix_GetError());
-    }
-    
-    tm->sfx_ball_brick = Mix_LoadWAV("docs/assets/SFX/ball_hit_brick.mp3");
-    if (!tm->sfx_ball_brick) {
-        printf("Warning: Failed to load ball brick SFX: %s\n", Mix_GetError());
+    if (tm->font_title && glyph_atlas_init(&tm->glyphs_title, renderer, tm->font_title) != 0) {
+        LOG_WARN(LOG_ASSETS, "Failed to build title glyph atlas, using text cache");
     }
     
-    tm->sfx_brick_break = Mix_LoadWAV("docs/assets/SFX/ball_break_brick.mp3");
-    if (!tm->sfx_brick_break) {
-        printf("Warning: Failed to load brick break SFX: %s\n", Mix_GetError());
-    }
-    
-    tm->sfx_lose_life = Mix_LoadWAV("docs/assets/SFX/lose_life.mp3");
-    if (!tm->sfx_lose_life) {
-        printf("Warning: Failed to load lose life SFX: %s\n", Mix_GetError());
-    }
-    
-    tm->sfx_menu_select = Mix_LoadWAV("docs/assets/SFX/menu_select.mp3");
-    if (!tm->sfx_menu_select) {
-        printf("Warning: Failed to load menu select SFX: %s\n", Mix_GetError());
+    // Everything else decodes on worker threads; title screen assets go first
+    // Images and audio are listed in the manifest and load on first acquire
+    LOG_DEBUG(LOG_ASSETS, "Reading asset manifest...");
+    if (asset_registry_init(&tm->assets, renderer, ASSET_MANIFEST_FILE) != 0) {
+        LOG_ERROR(LOG_ASSETS, "Failed to read asset manifest");
+        return -1;
     }
     
     return 0;
 }
 
 void texture_manager_cleanup(TextureManager* tm) {
-    printf("DEBUG: Destroying textures...\n");
-    if (tm->background.texture) {
-        SDL_DestroyTexture(tm->background.texture);
-        tm->background.texture = NULL;
-    }
-    if (tm->logo.texture) {
-        SDL_DestroyTexture(tm->logo.texture);
-        tm->logo.texture = NULL;
-    }
-    if (tm->dashie.texture) {
-        SDL_DestroyTexture(tm->dashie.texture);
-        tm->dashie.texture = NULL;
-    }
-    if (tm->kion_ded.texture) {
-        SDL_DestroyTexture(tm->kion_ded.texture);
-        tm->kion_ded.texture = NULL;
-    }
-    if (tm->kion_happi.texture) {
-        SDL_DestroyTexture(tm->kion_happi.texture);
-        tm->kion_happi.texture = NULL;
-    }
-    if (tm->arrow.texture) {
-        SDL_DestroyTexture(tm->arrow.texture);
-        tm->arrow.texture = NULL;
-    }
-    if (tm->ball.texture) {
-        SDL_DestroyTexture(tm->ball.texture);
-        tm->ball.texture = NULL;
-    }
-    if (tm->paddle.texture) {
-        SDL_DestroyTexture(tm->paddle.texture);
-        tm->paddle.texture = NULL;
-    }
-    if (tm->brick_red.texture) {
-        SDL_DestroyTexture(tm->brick_red.texture);
-        tm->brick_red.texture = NULL;
-    }
-    if (tm->brick_yellow.texture) {
-        SDL_DestroyTexture(tm->brick_yellow.texture);
-        tm->brick_yellow.texture = NULL;
-    }
-    if (tm->brick_green.texture) {
-        SDL_DestroyTexture(tm->brick_green.texture);
-        tm->brick_green.texture = NULL;
-    }
-    if (tm->brick_blue.texture) {
-        SDL_DestroyTexture(tm->brick_blue.texture);
-        tm->brick_blue.texture = NULL;
-    }
-    if (tm->brick_purple.texture) {
-        SDL_DestroyTexture(tm->brick_purple.texture);
-        tm->brick_purple.texture = NULL;
+    LOG_DEBUG(LOG_ASSETS, "Releasing assets...");
+    asset_registry_cleanup(&tm->assets);
+    
+    LOG_INFO(LOG_ASSETS, "Text cache: %u hits, %u misses", tm->text_cache.hits, tm->text_cache.misses);
+    text_cache_clear(&tm->text_cache);
+    glyph_atlas_cleanup(&tm->glyphs_regular);
+    glyph_atlas_cleanup(&tm->glyphs_title);
+    
+    if (tm->sprites.frames > 0) {
+        LOG_INFO(LOG_ASSETS, "Sprite batch: %.1f draw calls, %.1f vertices per frame over %d frames",
+                 (double)tm->sprites.total.draw_calls / tm->sprites.frames,
+                 (double)tm->sprites.total.vertices / tm->sprites.frames, tm->sprites.frames);
     }
+    sprite_batch_cleanup(&tm->sprites);
     
-    printf("DEBUG: Closing fonts...\n");
+    LOG_DEBUG(LOG_ASSETS, "Closing fonts...");
     if (tm->font_regular) {
         TTF_CloseFont(tm->font_regular);
         tm->font_regular = NULL;
@@ -283,66 +106,7 @@ void texture_manager_cleanup(TextureManager* tm) {
         tm->font_title = NULL;
     }
     
-    printf("DEBUG: Freeing audio assets...\n");
-    if (tm->bgm_title) {
-        Mix_FreeMusic(tm->bgm_title);
-        tm->bgm_title = NULL;
-    }
-    if (tm->bgm_stage1) {
-        Mix_FreeMusic(tm->bgm_stage1);
-        tm->bgm_stage1 = NULL;
-    }
-    if (tm->bgm_stage2) {
-        Mix_FreeMusic(tm->bgm_stage2);
-        tm->bgm_stage2 = NULL;
-    }
-    if (tm->bgm_stage3) {
-        Mix_FreeMusic(tm->bgm_stage3);
-        tm->bgm_stage3 = NULL;
-    }
-    if (tm->bgm_stage4) {
-        Mix_FreeMusic(tm->bgm_stage4);
-        tm->bgm_stage4 = NULL;
-    }
-    if (tm->bgm_stage5) {
-        Mix_FreeMusic(tm->bgm_stage5);
-        tm->bgm_stage5 = NULL;
-    }
-    if (tm->bgm_gameover) {
-        Mix_FreeMusic(tm->bgm_gameover);
-        tm->bgm_gameover = NULL;
-    }
-    if (tm->bgm_complete) {
-        Mix_FreeMusic(tm->bgm_complete);
-        tm->bgm_complete = NULL;
-    }
-    
-    if (tm->sfx_ball_paddle) {
-        Mix_FreeChunk(tm->sfx_ball_paddle);
-        tm->sfx_ball_paddle = NULL;
-    }
-    if (tm->sfx_ball_wall) {
-        Mix_FreeChunk(tm->sfx_ball_wall);
-        tm->sfx_ball_wall = NULL;
-    }
-    if (tm->sfx_ball_brick) {
-        Mix_FreeChunk(tm->sfx_ball_brick);
-        tm->sfx_ball_brick = NULL;
-    }
-    if (tm->sfx_brick_break) {
-        Mix_FreeChunk(tm->sfx_brick_break);
-        tm->sfx_brick_break = NULL;
-    }
-    if (tm->sfx_lose_life) {
-        Mix_FreeChunk(tm->sfx_lose_life);
-        tm->sfx_lose_life = NULL;
-    }
-    if (tm->sfx_menu_select) {
-        Mix_FreeChunk(tm->sfx_menu_select);
-        tm->sfx_menu_select = NULL;
-    }
-    
-    printf("DEBUG: Texture manager cleanup complete.\n");
+    LOG_DEBUG(LOG_ASSETS, "Texture manager cleanup complete.");
 }
 
 void render_texture(SDL_Renderer* renderer, SDL_Texture* texture, int x, int y, int width, int height) {
@@ -352,18 +116,27 @@ void render_texture(SDL_Renderer* renderer, SDL_Texture* texture, int x, int y,
     SDL_RenderCopy(renderer, texture, NULL, &dest_rect);
 }
 
+void draw_sprite(TextureManager* tm, const Texture* sprite, int x, int y, int width, int height) {
+    if (!sprite->texture) return;
+    
+    SDL_Color white = {255, 255, 255, 255};
+    const SDL_Rect* src = sprite->src.w > 0 ? &sprite->src : NULL;
+    sprite_batch_draw(&tm->sprites, sprite->texture, src, (float)x, (float)y, (float)width, (float)height, white);
+}
+
 SDL_Texture* create_text_texture(SDL_Renderer* renderer, TTF_Font* font, const char* text, SDL_Color color, int* width, int* height) {
+    TRACE_SCOPE("create_text_texture");
     if (!font || !text) return NULL;
     
     SDL_Surface* text_surface = TTF_RenderText_Solid(font, text, color);
     if (!text_surface) {
-        printf("Unable to render text surface! SDL_ttf Error: %s\n", TTF_GetError());
+        LOG_ERROR(LOG_ASSETS, "Unable to render text surface! SDL_ttf Error: %s", TTF_GetError());
         return NULL;
     }
     
     SDL_Texture* text_texture = SDL_CreateTextureFromSurface(renderer, text_surface);
     if (!text_texture) {
-        printf("Unable to create texture from rendered text! SDL Error: %s\n", SDL_GetError());
+        LOG_ERROR(LOG_ASSETS, "Unable to create texture from rendered text! SDL Error: %s", SDL_GetError());
     } else {
         if (width) *width = text_surface->w;
         if (height) *height = text_surface->h;
@@ -373,7 +146,327 @@ SDL_Texture* create_text_texture(SDL_Renderer* renderer, TTF_Font* font, const c
     return text_texture;
 }
 
+SDL_Texture* get_text_texture(TextureManager* tm, TTF_Font* font, const char* text, SDL_Color color, int* width, int* height) {
+    if (!font || !text) return NULL;
+    
+    TextCache* cache = &tm->text_cache;
+    size_t length = strlen(text);
+    bool cacheable = length < TEXT_CACHE_MAX_LEN;
+    TextCacheEntry* victim = &cache->entries[0];
+    
+    cache->use_counter++;
+    
+    for (int i = 0; i < TEXT_CACHE_SIZE; i++) {
+        TextCacheEntry* entry = &cache->entries[i];
+        
+        if (cacheable && entry->texture && entry->font == font &&
+            entry->color.r == color.r && entry->color.g == color.g &&
+            entry->color.b == color.b && entry->color.a == color.a &&
+            strcmp(entry->text, text) == 0) {
+            entry->last_used = cache->use_counter;
+            cache->hits++;
+            if (width) *width = entry->width;
+            if (height) *height = entry->height;
+            return entry->texture;
+        }
+        
+        // Prefer an empty slot, otherwise the least recently used one
+        if (victim->texture && (!entry->texture || entry->last_used < victim->last_used)) {
+            victim = entry;
+        }
+    }
+    
+    cache->misses++;
+    
+    if (victim->texture) {
+        SDL_DestroyTexture(victim->texture);
+        victim->texture = NULL;
+    }
+    
+    victim->texture = create_text_texture(tm->renderer, font, text, color, &victim->width, &victim->height);
+    if (!victim->texture) return NULL;
+    
+    // Strings too long for the key are still drawn, they just never match
+    victim->font = cacheable ? font : NULL;
+    victim->color = color;
+    if (cacheable) {
+        memcpy(victim->text, text, length + 1);
+    } else {
+        victim->text[0] = '\0';
+    }
+    victim->last_used = cache->use_counter;
+    
+    if (width) *width = victim->width;
+    if (height) *height = victim->height;
+    return victim->texture;
+}
+
+void text_cache_clear(TextCache* cache) {
+    for (int i = 0; i < TEXT_CACHE_SIZE; i++) {
+        if (cache->entries[i].texture) {
+            SDL_DestroyTexture(cache->entries[i].texture);
+            cache->entries[i].texture = NULL;
+        }
+        cache->entries[i].font = NULL;
+        cache->entries[i].text[0] = '\0';
+    }
+}
+
+static GlyphAtlas* glyph_atlas_for_font(TextureManager* tm, TTF_Font* font) {
+    if (font && tm->glyphs_regular.texture && tm->glyphs_regular.font == font) {
+        return &tm->glyphs_regular;
+    }
+    if (font && tm->glyphs_title.texture && tm->glyphs_title.font == font) {
+        return &tm->glyphs_title;
+    }
+    return NULL;
+}
+
+void measure_text(TextureManager* tm, TTF_Font* font, const char* text, int* width, int* height) {
+    if (width) *width = 0;
+    if (height) *height = 0;
+    if (!font || !text) return;
+    
+    GlyphAtlas* atlas = glyph_atlas_for_font(tm, font);
+    if (atlas) {
+        glyph_atlas_measure(atlas, text, width, height);
+    } else {
+        TTF_SizeText(font, text, width, height);
+    }
+}
+
+void draw_text(TextureManager* tm, TTF_Font* font, const char* text, int x, int y, SDL_Color color) {
+    if (!font || !text) return;
+    
+    GlyphAtlas* atlas = glyph_atlas_for_font(tm, font);
+    if (atlas) {
+        glyph_atlas_draw(atlas, &tm->sprites, text, x, y, color);
+        return;
+    }
+    
+    int width, height;
+    SDL_Texture* texture = get_text_texture(tm, font, text, color, &width, &height);
+    if (texture) {
+        SDL_Color white = {255, 255, 255, 255};
+        sprite_batch_draw(&tm->sprites, texture, NULL, (float)x, (float)y, (float)width, (float)height, white);
+    }
+}
+
+typedef struct {
+    int priority;
+    Uint64 started;       // Play order, so the oldest of equals is stolen first
+} SfxVoice;
+
+// The mixer is process-wide, and so is the state kept alongside it
+static struct {
+    bool open;
+    int chunk_size;
+    int voice_count;
+    SfxVoice voices[SFX_VOICES];
+    Uint64 play_counter;
+    Uint32 played;
+    Uint32 stolen;
+    Uint32 dropped;
+    
+    // Touched only by the mixer thread, apart from the counters
+    int bytes_per_second;
+    Uint64 last_callback;
+    SDL_atomic_t callbacks;
+    SDL_atomic_t late_callbacks;
+} audio;
+
+// Runs on the mixer thread once per buffer. SDL 2 reports no underruns for
+// callback-driven devices like the mixer's (SDL_GetQueuedAudioSize only covers
+// SDL_QueueAudio), so this timing estimate is the underrun count: the device
+// pulls buffers at a steady rate, and one arriving well over a period after
+// the last suggests it ran dry. A device queue deeper than one period can
+// absorb such a gap, and underruns inside the driver go unseen.
+static void audio_post_mix(void* user_data, Uint8* stream, int length) {
+    (void)user_data;
+    (void)stream;
+    
+    Uint64 now = SDL_GetPerformanceCounter();
+    Uint64 period = (Uint64)length * SDL_GetPerformanceFrequency() / (Uint64)audio.bytes_per_second;
+    if (audio.last_callback && now - audio.last_callback > period + period / 2) {
+        SDL_AtomicAdd(&audio.late_callbacks, 1);
+    }
+    audio.last_callback = now;
+    SDL_AtomicAdd(&audio.callbacks, 1);
+}
+
+void audio_init(int chunk_size) {
+    int frequency = 0, channels = 0;
+    Uint16 format = 0;
+    if (!Mix_QuerySpec(&frequency, &format, &channels)) return;
+    
+    memset(&audio, 0, sizeof(audio));
+    audio.open = true;
+    audio.chunk_size = chunk_size;
+    audio.bytes_per_second = frequency * channels * (SDL_AUDIO_BITSIZE(format) / 8);
+    audio.voice_count = Mix_AllocateChannels(SFX_VOICES);
+    Mix_SetPostMix(audio_post_mix, NULL);
+    LOG_INFO(LOG_AUDIO, "Audio buffer %d samples (%.1f ms), %d SFX voices",
+             chunk_size, chunk_size * 1000.0 / frequency, audio.voice_count);
+}
+
+void audio_cleanup(void) {
+    if (!audio.open) return;
+    
+    Mix_SetPostMix(NULL, NULL);
+    LOG_INFO(LOG_AUDIO, "Audio: %d estimated underruns (late mix callbacks) in %d buffers of %d samples",
+             SDL_AtomicGet(&audio.late_callbacks), SDL_AtomicGet(&audio.callbacks), audio.chunk_size);
+    LOG_INFO(LOG_AUDIO, "SFX voices: %u played, %u stolen, %u dropped",
+             audio.played, audio.stolen, audio.dropped);
+    audio.open = false;
+}
+
+// Reads the file in fixed MUSIC_STREAM_CHUNK blocks whatever the decoder
+// asks for, so memory stays bounded and the card sees few, large reads
+typedef struct {
+    SDL_RWops* file;
+    Sint64 file_position; // Where the next read from file lands
+    Sint64 size;
+    Sint64 position;      // Decoder's position in the file
+    Sint64 chunk_start;   // File offset of chunk[0]
+    size_t chunk_length;
+    Uint32 reads;
+    Uint64 bytes_read;
+    char path[ASSET_PACK_PATH_MAX];
+    Uint8 chunk[MUSIC_STREAM_CHUNK];
+} MusicStream;
+
+static Sint64 music_stream_size(SDL_RWops* rw) {
+    MusicStream* stream = rw->hidden.unknown.data1;
+    return stream->size;
+}
+
+static Sint64 music_stream_seek(SDL_RWops* rw, Sint64 offset, int whence) {
+    MusicStream* stream = rw->hidden.unknown.data1;
+    Sint64 position;
+    switch (whence) {
+        case RW_SEEK_SET: position = offset; break;
+        case RW_SEEK_CUR: position = stream->position + offset; break;
+        case RW_SEEK_END: position = stream->size + offset; break;
+        default: return SDL_SetError("Unknown seek mode");
+    }
+    if (position < 0) {
+        return SDL_SetError("Seek before start of %s", stream->path);
+    }
+    
+    // Nothing is read until the decoder asks for data
+    stream->position = position;
+    return position;
+}
+
+static size_t music_stream_read(SDL_RWops* rw, void* ptr, size_t size, size_t maxnum) {
+    MusicStream* stream = rw->hidden.unknown.data1;
+    size_t wanted = size * maxnum;
+    size_t copied = 0;
+    if (size == 0) return 0;
+    
+    while (copied < wanted) {
+        Sint64 offset = stream->position - stream->chunk_start;
+        if (offset < 0 || offset >= (Sint64)stream->chunk_length) {
+            // Refill with the block holding the current position
+            stream->chunk_start = stream->position;
+            stream->chunk_length = 0;
+            if (stream->file_position != stream->chunk_start) {
+                if (SDL_RWseek(stream->file, stream->chunk_start, RW_SEEK_SET) < 0) break;
+                stream->file_position = stream->chunk_start;
+            }
+            stream->chunk_length = SDL_RWread(stream->file, stream->chunk, 1, MUSIC_STREAM_CHUNK);
+            stream->file_position += stream->chunk_length;
+            if (stream->chunk_length == 0) break;
+            stream->reads++;
+            stream->bytes_read += stream->chunk_length;
+            offset = 0;
+        }
+        
+        size_t available = stream->chunk_length - (size_t)offset;
+        size_t count = wanted - copied < available ? wanted - copied : available;
+        memcpy((Uint8*)ptr + copied, stream->chunk + offset, count);
+        copied += count;
+        stream->position += count;
+    }
+    return copied / size;
+}
+
+static size_t music_stream_write(SDL_RWops* rw, const void* ptr, size_t size, size_t num) {
+    (void)rw;
+    (void)ptr;
+    (void)size;
+    (void)num;
+    SDL_SetError("Music streams are read-only");
+    return 0;
+}
+
+static int music_stream_close(SDL_RWops* rw) {
+    MusicStream* stream = rw->hidden.unknown.data1;
+    LOG_INFO(LOG_AUDIO, "Streamed %s: %.1f KiB of %.1f KiB in %u reads", stream->path,
+             stream->bytes_read / 1024.0, stream->size / 1024.0, stream->reads);
+    SDL_RWclose(stream->file);
+    free(stream);
+    SDL_FreeRW(rw);
+    return 0;
+}
+
+static SDL_RWops* music_stream_open(const char* path) {
+    SDL_RWops* file = SDL_RWFromFile(path, "rb");
+    if (!file) return NULL;
+    
+    MusicStream* stream = calloc(1, sizeof(MusicStream));
+    SDL_RWops* rw = SDL_AllocRW();
+    if (!stream || !rw) {
+        free(stream);
+        if (rw) SDL_FreeRW(rw);
+        SDL_RWclose(file);
+        return NULL;
+    }
+    stream->file = file;
+    stream->size = SDL_RWsize(file);
+    snprintf(stream->path, sizeof(stream->path), "%s", path);
+    
+    rw->size = music_stream_size;
+    rw->seek = music_stream_seek;
+    rw->read = music_stream_read;
+    rw->write = music_stream_write;
+    rw->close = music_stream_close;
+    rw->type = SDL_RWOPS_UNKNOWN;
+    rw->hidden.unknown.data1 = stream;
+    return rw;
+}
+
+static Mix_Music* load_music_file(const char* path) {
+    SDL_RWops* rw = music_stream_open(path);
+    if (!rw) return NULL;
+    
+    // The music owns the stream from here and closes it when freed
+    return Mix_LoadMUS_RW(rw, 1);
+}
+
+Mix_Music* load_music(const char* path) {
+    Mix_Music* music = NULL;
+    
+    // `make bgm` writes an Ogg Vorbis copy next to each WAV; the WAV is
+    // still used when there is none or the mixer can't decode it
+    char compressed[ASSET_PACK_PATH_MAX];
+    size_t length = strlen(path);
+    if (length > 4 && length < sizeof(compressed) && SDL_strcasecmp(path + length - 4, ".wav") == 0) {
+        memcpy(compressed, path, length - 4);
+        strcpy(compressed + length - 4, ".ogg");
+        music = load_music_file(compressed);
+    }
+    if (!music) {
+        music = load_music_file(path);
+    }
+    if (!music) {
+        LOG_WARN(LOG_AUDIO, "Failed to load BGM %s: %s", path, Mix_GetError());
+    }
+    return music;
+}
+
 void play_bgm(Mix_Music* music) {
+    TRACE_SCOPE("play_bgm");
     if (!music) return;
     
     // Stop current music if playing
@@ -392,8 +485,41 @@ void stop_bgm(void) {
     }
 }
 
-void play_sfx(Mix_Chunk* chunk) {
-    if (!chunk) return;
+void play_sfx(Mix_Chunk* chunk, int priority) {
+    if (!chunk || !audio.open) return;
+    
+    int channel = -1;
+    for (int i = 0; i < audio.voice_count; i++) {
+        if (!Mix_Playing(i)) {
+            channel = i;
+            break;
+        }
+    }
     
-    Mix_PlayChannel(-1, chunk, 0);
+    // Every voice is busy: take the least important one, oldest first
+    if (channel < 0) {
+        for (int i = 0; i < audio.voice_count; i++) {
+            const SfxVoice* voice = &audio.voices[i];
+            if (voice->priority > priority) continue;
+            if (channel < 0 || voice->priority < audio.voices[channel].priority ||
+                (voice->priority == audio.voices[channel].priority &&
+                 voice->started < audio.voices[channel].started)) {
+                channel = i;
+            }
+        }
+        if (channel < 0) {
+            audio.dropped++;
+            return;
+        }
+        audio.stolen++;
+    }
+    
+    // Playing on a busy channel cuts off whatever it had
+    if (Mix_PlayChannel(channel, chunk, 0) < 0) {
+        audio.dropped++;
+        return;
+    }
+    audio.voices[channel].priority = priority;
+    audio.voices[channel].started = ++audio.play_counter;
+    audio.played++;
 }
\ No newline at end of file
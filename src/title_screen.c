@@ -1,30 +1,72 @@
 #include "title_screen.h"
 #include "game.h"
+#include "log.h"
 #include <math.h>
 
 void title_screen_init(TitleScreen* ts, TextureManager* tm) {
     ts->current_option = MENU_START_GAME;
     ts->arrow_rotation = 0.0f;
     ts->texture_manager = tm;
+    ts->shown = false;
     
-    // Start title screen BGM
-    play_bgm(tm->bgm_title);
+    ts->background = asset_acquire(&tm->assets, "background");
+    ts->logo = asset_acquire(&tm->assets, "logo");
+    ts->dashie = asset_acquire(&tm->assets, "dashie");
+    ts->arrow = asset_acquire(&tm->assets, "arrow");
+    ts->menu_select = asset_acquire(&tm->assets, "sfx_menu_select");
+    ts->bgm = asset_acquire(&tm->assets, "bgm_title");
+    
+    // Start title screen BGM, or once it has loaded
+    asset_play_music(&tm->assets, ts->bgm);
+}
+
+void title_screen_cleanup(TitleScreen* ts) {
+    AssetRegistry* assets = &ts->texture_manager->assets;
+    asset_release(assets, ts->background);
+    asset_release(assets, ts->logo);
+    asset_release(assets, ts->dashie);
+    asset_release(assets, ts->arrow);
+    asset_release(assets, ts->menu_select);
+    asset_release(assets, ts->bgm);
+}
+
+// The screen is held back until its own images are in, so nothing pops in
+static bool title_screen_ready(TitleScreen* ts) {
+    AssetRegistry* assets = &ts->texture_manager->assets;
+    return asset_ready(assets, ts->background) && asset_ready(assets, ts->logo) &&
+           asset_ready(assets, ts->dashie) && asset_ready(assets, ts->arrow);
+}
+
+static void title_screen_render_loading(TitleScreen* ts, SDL_Renderer* renderer) {
+    float progress = asset_registry_progress(&ts->texture_manager->assets);
+    int bar_width = 300;
+    int bar_x = (WINDOW_WIDTH - bar_width) / 2;
+    int bar_y = WINDOW_HEIGHT - 40;
+    
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_Rect track = {bar_x, bar_y, bar_width, 8};
+    SDL_RenderFillRect(renderer, &track);
+    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+    SDL_Rect fill = {bar_x, bar_y, (int)(bar_width * progress), 8};
+    SDL_RenderFillRect(renderer, &fill);
 }
 
 void title_screen_handle_input(TitleScreen* ts, SDL_Event* e, int* next_state) {
+    if (!title_screen_ready(ts)) return;
+    
     if (e->type == SDL_KEYDOWN) {
         switch (e->key.keysym.sym) {
             case SDLK_UP:
                 ts->current_option = (ts->current_option - 1 + MENU_COUNT) % MENU_COUNT;
-                play_sfx(ts->texture_manager->sfx_menu_select);
+                asset_play_sound(&ts->texture_manager->assets, ts->menu_select);
                 break;
             case SDLK_DOWN:
                 ts->current_option = (ts->current_option + 1) % MENU_COUNT;
-                play_sfx(ts->texture_manager->sfx_menu_select);
+                asset_play_sound(&ts->texture_manager->assets, ts->menu_select);
                 break;
             case SDLK_RETURN:
             case SDLK_SPACE:
-                play_sfx(ts->texture_manager->sfx_menu_select);
+                asset_play_sound(&ts->texture_manager->assets, ts->menu_select);
                 if (ts->current_option == MENU_START_GAME) {
                     *next_state = GAME_STATE_GAMEPLAY;
                 } else if (ts->current_option == MENU_QUIT_GAME) {
@@ -43,26 +85,41 @@ void title_screen_update(TitleScreen* ts, float delta_time) {
 }
 
 void title_screen_render(TitleScreen* ts, SDL_Renderer* renderer) {
-    if (ts->texture_manager->background.texture) {
-        render_texture(renderer, ts->texture_manager->background.texture, 
+    if (!title_screen_ready(ts)) {
+        title_screen_render_loading(ts, renderer);
+        return;
+    }
+    if (!ts->shown) {
+        ts->shown = true;
+        LOG_INFO(LOG_GAME, "Title screen ready %u ms after SDL init", (unsigned)SDL_GetTicks());
+    }
+    
+    AssetRegistry* assets = &ts->texture_manager->assets;
+    const Texture* background = asset_texture(assets, ts->background);
+    const Texture* logo = asset_texture(assets, ts->logo);
+    const Texture* dashie = asset_texture(assets, ts->dashie);
+    const Texture* arrow = asset_texture(assets, ts->arrow);
+    
+    if (background->texture) {
+        render_texture(renderer, background->texture, 
                       0, 0, WINDOW_WIDTH, WINDOW_HEIGHT);
     }
     
-    if (ts->texture_manager->logo.texture) {
+    if (logo->texture) {
         int logo_width = 300;
-        int logo_height = (ts->texture_manager->logo.height * logo_width) / ts->texture_manager->logo.width;
+        int logo_height = (logo->height * logo_width) / logo->width;
         int logo_x = 50;
         int logo_y = 50;
-        render_texture(renderer, ts->texture_manager->logo.texture, 
+        render_texture(renderer, logo->texture, 
                       logo_x, logo_y, logo_width, logo_height);
     }
     
-    if (ts->texture_manager->dashie.texture) {
-        int dashie_width = ts->texture_manager->dashie.width;
-        int dashie_height = ts->texture_manager->dashie.height;
+    if (dashie->texture) {
+        int dashie_width = dashie->width;
+        int dashie_height = dashie->height;
         int dashie_x = WINDOW_WIDTH - dashie_width - 10;
         int dashie_y = WINDOW_HEIGHT - dashie_height;
-        render_texture(renderer, ts->texture_manager->dashie.texture, 
+        render_texture(renderer, dashie->texture, 
                       dashie_x, dashie_y, dashie_width, dashie_height);
     }
     
@@ -77,20 +134,18 @@ void title_screen_render(TitleScreen* ts, SDL_Renderer* renderer) {
         SDL_Color text_color = (i == (int)ts->current_option) ? yellow_color : white_color;
         
         if (ts->texture_manager->font_regular) {
-            SDL_Texture* text_texture = create_text_texture(renderer, ts->texture_manager->font_regular, 
-                                                           menu_items[i], text_color, &text_width, &text_height);
-            if (text_texture) {
-                int text_x = menu_x;
-                int text_y = menu_y + i * 50;
-                render_texture(renderer, text_texture, text_x, text_y, text_width, text_height);
-                SDL_DestroyTexture(text_texture);
-                
-                if (i == (int)ts->current_option && ts->texture_manager->arrow.texture) {
-                    int arrow_x = menu_x - 40;
-                    int arrow_y = text_y + (text_height - ts->texture_manager->arrow.height) / 2;
-                    render_texture(renderer, ts->texture_manager->arrow.texture, 
-                                  arrow_x, arrow_y, ts->texture_manager->arrow.width, ts->texture_manager->arrow.height);
-                }
+            int text_x = menu_x;
+            int text_y = menu_y + i * 50;
+            measure_text(ts->texture_manager, ts->texture_manager->font_regular, 
+                         menu_items[i], &text_width, &text_height);
+            draw_text(ts->texture_manager, ts->texture_manager->font_regular, 
+                      menu_items[i], text_x, text_y, text_color);
+            
+            if (i == (int)ts->current_option && arrow->texture) {
+                int arrow_x = menu_x - 40;
+                int arrow_y = text_y + (text_height - arrow->height) / 2;
+                draw_sprite(ts->texture_manager, arrow,
+                            arrow_x, arrow_y, arrow->width, arrow->height);
             }
         } else {
             SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
@@ -104,4 +159,9 @@ void title_screen_render(TitleScreen* ts, SDL_Renderer* renderer) {
             }
         }
     }
+    
+    // The rest of the game keeps loading in the background
+    if (asset_registry_busy(assets)) {
+        title_screen_render_loading(ts, renderer);
+    }
 }
\ No newline at end of file
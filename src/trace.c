@@ -0,0 +1,151 @@
+#include "trace.h"
+#include "log.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+static struct {
+    bool initialized;
+    SDL_TLSID ring_key;
+    TraceRing* rings[TRACE_MAX_THREADS];
+    SDL_atomic_t ring_count;
+    SDL_atomic_t dropped;     // Events from threads past TRACE_MAX_THREADS
+    Uint64 base;              // Counter value at trace_init, time zero in the file
+    Uint64 frequency;
+    int dumps;
+} trace;
+
+void trace_init(void) {
+    if (trace.initialized) return;
+    trace.ring_key = SDL_TLSCreate();
+    trace.base = SDL_GetPerformanceCounter();
+    trace.frequency = SDL_GetPerformanceFrequency();
+    trace.initialized = trace.ring_key != 0;
+    if (!trace.initialized) {
+        LOG_WARN(LOG_TRACE, "Tracing disabled, no thread-local storage: %s", SDL_GetError());
+    }
+}
+
+static TraceRing* trace_thread_ring(void) {
+    TraceRing* ring = SDL_TLSGet(trace.ring_key);
+    if (ring) return ring;
+    
+    // First event on this thread: claim a slot. Rings live until exit, so a
+    // dump can still read threads that have finished.
+    int slot = SDL_AtomicAdd(&trace.ring_count, 1);
+    if (slot >= TRACE_MAX_THREADS) {
+        SDL_AtomicAdd(&trace.ring_count, -1);
+        return NULL;
+    }
+    ring = calloc(1, sizeof(TraceRing));
+    if (!ring) {
+        return NULL; // The slot stays empty; dumps skip it
+    }
+    ring->thread_id = SDL_ThreadID();
+    SDL_TLSSet(trace.ring_key, ring, NULL);
+    SDL_MemoryBarrierRelease();
+    trace.rings[slot] = ring;
+    return ring;
+}
+
+void trace_set_thread_name(const char* name) {
+    if (!trace.initialized) return;
+    TraceRing* ring = trace_thread_ring();
+    if (ring) ring->thread_name = name;
+}
+
+TraceScope trace_scope_begin(const char* name) {
+    TraceScope scope = {name, SDL_GetPerformanceCounter()};
+    return scope;
+}
+
+void trace_scope_end(TraceScope* scope) {
+    Uint64 end = SDL_GetPerformanceCounter();
+    if (!trace.initialized) return;
+    TraceRing* ring = trace_thread_ring();
+    if (!ring) {
+        SDL_AtomicAdd(&trace.dropped, 1);
+        return;
+    }
+    
+    int head = SDL_AtomicGet(&ring->head);
+    TraceEvent* event = &ring->events[(unsigned)head % TRACE_RING_EVENTS];
+    event->name = scope->name;
+    event->start = scope->start;
+    event->duration = end - scope->start;
+    SDL_AtomicSet(&ring->head, head + 1);
+}
+
+static double trace_us(Uint64 ticks) {
+    return (double)ticks * 1000000.0 / (double)trace.frequency;
+}
+
+bool trace_dump(const char* path) {
+    if (!trace.initialized) return false;
+    
+    char numbered[64];
+    if (!path) {
+        snprintf(numbered, sizeof(numbered), "brickout-trace-%d.json", ++trace.dumps);
+        path = numbered;
+    }
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        LOG_WARN(LOG_TRACE, "Unable to write trace %s", path);
+        return false;
+    }
+    
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"brickout\"}}");
+    
+    int written = 0;
+    int ring_count = SDL_AtomicGet(&trace.ring_count);
+    SDL_MemoryBarrierAcquire();
+    for (int r = 0; r < ring_count && r < TRACE_MAX_THREADS; r++) {
+        TraceRing* ring = trace.rings[r];
+        if (!ring) continue;
+        unsigned long tid = (unsigned long)ring->thread_id;
+        if (ring->thread_name) {
+            fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%lu,"
+                    "\"args\":{\"name\":\"%s\"}}", tid, ring->thread_name);
+        }
+        
+        // Threads keep recording while this runs; events the writer may
+        // have lapped in the meantime are left out rather than read torn
+        int head = SDL_AtomicGet(&ring->head);
+        int first = head > TRACE_RING_EVENTS ? head - TRACE_RING_EVENTS : 0;
+        for (int i = first; i < head; i++) {
+            TraceEvent event = ring->events[(unsigned)i % TRACE_RING_EVENTS];
+            int now_head = SDL_AtomicGet(&ring->head);
+            if (now_head - i >= TRACE_RING_EVENTS) continue;
+            fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%lu,\"ts\":%.3f,\"dur\":%.3f}",
+                    event.name, tid, trace_us(event.start - trace.base), trace_us(event.duration));
+            written++;
+        }
+    }
+    fprintf(file, "\n]}\n");
+    
+    if (fclose(file) != 0) {
+        LOG_WARN(LOG_TRACE, "Unable to write trace %s", path);
+        return false;
+    }
+    int dropped = SDL_AtomicGet(&trace.dropped);
+    if (dropped > 0) {
+        LOG_INFO(LOG_TRACE, "Wrote %d trace events to %s (%d dropped from threads past %d)",
+                 written, path, dropped, TRACE_MAX_THREADS);
+    } else {
+        LOG_INFO(LOG_TRACE, "Wrote %d trace events to %s", written, path);
+    }
+    return true;
+}
+
+void trace_shutdown(void) {
+    if (!trace.initialized) return;
+    trace_dump(TRACE_FILE);
+    
+    // Worker threads are joined by now, nothing writes to the rings
+    for (int r = 0; r < TRACE_MAX_THREADS; r++) {
+        free(trace.rings[r]);
+        trace.rings[r] = NULL;
+    }
+    SDL_AtomicSet(&trace.ring_count, 0);
+    trace.initialized = false;
+}
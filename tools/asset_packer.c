@@ -0,0 +1,174 @@
+// Offline packer: decodes images to RGBA32 and sound effects to the
+// mixer's output format, then writes them all into one mappable file.
+//
+//     asset_packer <output> <file>...
+//
+// Paths are stored exactly as given, so run it from the repository root
+// with the same relative paths the game loads.
+#include "asset_pack.h"
+#include <SDL_image.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    AssetPackEntry entry;
+    SDL_Surface* surface;
+    Mix_Chunk* chunk;
+} PackItem;
+
+static bool has_extension(const char* path, const char* extension) {
+    size_t path_len = strlen(path);
+    size_t ext_len = strlen(extension);
+    return path_len > ext_len && SDL_strcasecmp(path + path_len - ext_len, extension) == 0;
+}
+
+static Uint64 align_offset(Uint64 offset) {
+    return (offset + ASSET_PACK_ALIGN - 1) & ~(Uint64)(ASSET_PACK_ALIGN - 1);
+}
+
+static bool pack_item_load(PackItem* item, const char* path) {
+    memset(item, 0, sizeof(*item));
+    if (strlen(path) >= ASSET_PACK_PATH_MAX) {
+        fprintf(stderr, "Path too long for the pack: %s\n", path);
+        return false;
+    }
+    strcpy(item->entry.path, path);
+    
+    if (has_extension(path, ".png") || has_extension(path, ".webp") || has_extension(path, ".jpg")) {
+        SDL_Surface* loaded = IMG_Load(path);
+        if (!loaded) {
+            fprintf(stderr, "Unable to load image %s: %s\n", path, IMG_GetError());
+            return false;
+        }
+        item->surface = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+        SDL_FreeSurface(loaded);
+        if (!item->surface) {
+            fprintf(stderr, "Unable to convert %s: %s\n", path, SDL_GetError());
+            return false;
+        }
+        item->entry.kind = ASSET_PACK_IMAGE;
+        item->entry.width = (Uint32)item->surface->w;
+        item->entry.height = (Uint32)item->surface->h;
+        item->entry.pitch = (Uint32)item->surface->w * 4;
+        item->entry.size = (Uint64)item->entry.pitch * item->entry.height;
+        return true;
+    }
+    
+    if (has_extension(path, ".mp3") || has_extension(path, ".wav") || has_extension(path, ".ogg")) {
+        // Mix_LoadWAV resamples to the format the mixer was opened with
+        item->chunk = Mix_LoadWAV(path);
+        if (!item->chunk) {
+            fprintf(stderr, "Unable to load sound %s: %s\n", path, Mix_GetError());
+            return false;
+        }
+        int frequency, channels;
+        Uint16 format;
+        Mix_QuerySpec(&frequency, &format, &channels);
+        item->entry.kind = ASSET_PACK_PCM;
+        item->entry.frequency = (Uint32)frequency;
+        item->entry.format = format;
+        item->entry.channels = (Uint16)channels;
+        item->entry.size = item->chunk->alen;
+        return true;
+    }
+    
+    fprintf(stderr, "Don't know how to pack %s\n", path);
+    return false;
+}
+
+static bool write_pack(const char* output, PackItem* items, int count) {
+    AssetPackHeader header = {ASSET_PACK_MAGIC, ASSET_PACK_VERSION, (Uint32)count, 0};
+    
+    Uint64 offset = align_offset(sizeof(header) + (Uint64)count * sizeof(AssetPackEntry));
+    for (int i = 0; i < count; i++) {
+        items[i].entry.offset = offset;
+        offset = align_offset(offset + items[i].entry.size);
+    }
+    
+    FILE* file = fopen(output, "wb");
+    if (!file) {
+        fprintf(stderr, "Unable to open %s for writing\n", output);
+        return false;
+    }
+    
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    for (int i = 0; i < count && ok; i++) {
+        ok = fwrite(&items[i].entry, sizeof(AssetPackEntry), 1, file) == 1;
+    }
+    
+    static const Uint8 zeros[ASSET_PACK_ALIGN];
+    for (int i = 0; i < count && ok; i++) {
+        long position = ftell(file);
+        long padding = (long)items[i].entry.offset - position;
+        if (padding > 0) {
+            ok = fwrite(zeros, 1, (size_t)padding, file) == (size_t)padding;
+        }
+        
+        // Image rows are written tightly packed, whatever the surface pitch
+        if (ok && items[i].surface) {
+            SDL_Surface* surface = items[i].surface;
+            for (int y = 0; y < surface->h && ok; y++) {
+                const Uint8* row = (const Uint8*)surface->pixels + y * surface->pitch;
+                ok = fwrite(row, items[i].entry.pitch, 1, file) == 1;
+            }
+        } else if (ok && items[i].entry.size > 0) {
+            ok = fwrite(items[i].chunk->abuf, (size_t)items[i].entry.size, 1, file) == 1;
+        }
+    }
+    
+    if (fclose(file) != 0) ok = false;
+    if (!ok) {
+        fprintf(stderr, "Failed writing %s\n", output);
+        remove(output);
+    }
+    return ok;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s <output> <file>...\n", argv[0]);
+        return 1;
+    }
+    
+    // No sound is played, so don't insist on a real audio device
+    SDL_setenv("SDL_AUDIODRIVER", "dummy", 0);
+    if (SDL_Init(SDL_INIT_AUDIO) < 0) {
+        fprintf(stderr, "SDL could not initialize! SDL_Error: %s\n", SDL_GetError());
+        return 1;
+    }
+    IMG_Init(IMG_INIT_PNG | IMG_INIT_JPG | IMG_INIT_WEBP);
+    Mix_Init(MIX_INIT_MP3 | MIX_INIT_OGG);
+    if (Mix_OpenAudio(AUDIO_FREQUENCY, AUDIO_FORMAT, AUDIO_CHANNELS, AUDIO_CHUNK_SIZE) < 0) {
+        fprintf(stderr, "SDL_mixer could not initialize! SDL_mixer Error: %s\n", Mix_GetError());
+        return 1;
+    }
+    
+    int count = argc - 2;
+    PackItem* items = calloc((size_t)count, sizeof(PackItem));
+    bool ok = items != NULL;
+    for (int i = 0; i < count && ok; i++) {
+        ok = pack_item_load(&items[i], argv[i + 2]);
+    }
+    if (ok) {
+        ok = write_pack(argv[1], items, count);
+    }
+    
+    Uint64 total = 0;
+    for (int i = 0; items && i < count; i++) {
+        total += items[i].entry.size;
+        if (items[i].surface) SDL_FreeSurface(items[i].surface);
+        if (items[i].chunk) Mix_FreeChunk(items[i].chunk);
+    }
+    free(items);
+    
+    if (ok) {
+        printf("Packed %d assets (%llu KB) into %s\n", count, (unsigned long long)(total / 1024), argv[1]);
+    }
+    
+    Mix_CloseAudio();
+    Mix_Quit();
+    IMG_Quit();
+    SDL_Quit();
+    return ok ? 0 : 1;
+}
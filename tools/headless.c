@@ -0,0 +1,220 @@
+// Runs the gameplay simulation without a window, renderer or audio device,
+// driving the paddle from an input script, and reports how the games went.
+//
+//     headless [--games N] [--seed S] [--max-ticks T] [--script FILE]
+//     headless [--games N] --replay FILE
+//     headless [--games N] [--seed S] [--max-ticks T] --autoplay
+//
+// A script is a list of "<ticks> <keys>" lines, where keys is L, R, LR or -
+// for nothing held. It loops for as long as a game lasts. '#' starts a
+// comment. Without --script the paddle sweeps back and forth.
+//
+// With --replay every game replays a recording made with `brickout --record`
+// and checks it ends in the recorded state, so a replay doubles as a fixed
+// workload for timing the simulation.
+//
+// With --autoplay the computer player from autoplay.c plays instead of a
+// script. It is expected to clear all five stages, so runs that lose or
+// hit --max-ticks are worth a look; together with the timings that makes
+// a soak test as well as a benchmark.
+#include "game.h"
+#include "replay.h"
+#include "autoplay.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define HEADLESS_SCRIPT_MAX 256
+#define HEADLESS_DEFAULT_GAMES 1000
+#define HEADLESS_DEFAULT_MAX_TICKS (SIMULATION_HZ * 60 * 10) // Ten minutes of play
+
+typedef struct {
+    int ticks;
+    GameplayInput input;
+} ScriptStep;
+
+typedef struct {
+    ScriptStep steps[HEADLESS_SCRIPT_MAX];
+    int count;
+    int total_ticks;
+} InputScript;
+
+static void script_add(InputScript* script, int ticks, bool left, bool right) {
+    ScriptStep* step = &script->steps[script->count++];
+    step->ticks = ticks;
+    step->input.left = left;
+    step->input.right = right;
+    script->total_ticks += ticks;
+}
+
+static bool script_load(InputScript* script, const char* path) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "Unable to open input script %s\n", path);
+        return false;
+    }
+    
+    char line[128];
+    int line_number = 0;
+    while (fgets(line, sizeof(line), file)) {
+        line_number++;
+        line[strcspn(line, "#\r\n")] = '\0';
+    
+        int ticks;
+        char keys[8];
+        if (sscanf(line, "%d %7s", &ticks, keys) != 2) continue;
+        if (ticks <= 0 || script->count >= HEADLESS_SCRIPT_MAX) {
+            fprintf(stderr, "%s:%d: ignoring step\n", path, line_number);
+            continue;
+        }
+        script_add(script, ticks, strchr(keys, 'L') != NULL, strchr(keys, 'R') != NULL);
+    }
+    fclose(file);
+    
+    if (script->count == 0) {
+        fprintf(stderr, "Input script %s has no steps\n", path);
+        return false;
+    }
+    return true;
+}
+
+static const GameplayInput* script_input(const InputScript* script, int tick) {
+    int offset = tick % script->total_ticks;
+    for (int i = 0; i < script->count; i++) {
+        if (offset < script->steps[i].ticks) {
+            return &script->steps[i].input;
+        }
+        offset -= script->steps[i].ticks;
+    }
+    return &script->steps[script->count - 1].input;
+}
+
+static bool parse_int(const char* text, int* value) {
+    char* end;
+    long parsed = strtol(text, &end, 10);
+    if (*text == '\0' || *end != '\0' || parsed < 0 || parsed > 0x7fffffff) {
+        return false;
+    }
+    *value = (int)parsed;
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    int games = HEADLESS_DEFAULT_GAMES;
+    int seed = 1;
+    int max_ticks = HEADLESS_DEFAULT_MAX_TICKS;
+    const char* script_path = NULL;
+    const char* replay_path = NULL;
+    bool autoplay = false;
+    
+    for (int i = 1; i < argc; i++) {
+        bool has_value = i + 1 < argc;
+        bool ok = has_value;
+        if (strcmp(argv[i], "--autoplay") == 0) {
+            autoplay = ok = true;
+        } else if (strcmp(argv[i], "--games") == 0 && has_value) {
+            ok = parse_int(argv[++i], &games);
+        } else if (strcmp(argv[i], "--seed") == 0 && has_value) {
+            ok = parse_int(argv[++i], &seed);
+        } else if (strcmp(argv[i], "--max-ticks") == 0 && has_value) {
+            ok = parse_int(argv[++i], &max_ticks);
+        } else if (strcmp(argv[i], "--script") == 0 && has_value) {
+            script_path = argv[++i];
+        } else if (strcmp(argv[i], "--replay") == 0 && has_value) {
+            replay_path = argv[++i];
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            fprintf(stderr, "usage: %s [--games N] [--seed S] [--max-ticks T] [--script FILE | --replay FILE | --autoplay]\n", argv[0]);
+            return 2;
+        }
+    }
+    
+    Replay replay;
+    memset(&replay, 0, sizeof(replay));
+    if (replay_path) {
+        if (!replay_load(&replay, replay_path)) return 1;
+        max_ticks = replay.tick_count;
+    }
+    
+    InputScript script;
+    memset(&script, 0, sizeof(script));
+    if (script_path) {
+        if (!script_load(&script, script_path)) return 1;
+    } else {
+        // Cross the field one way, then the other
+        script_add(&script, SIMULATION_HZ, true, false);
+        script_add(&script, SIMULATION_HZ, false, true);
+    }
+    
+    TRACE_INIT();
+    Gameplay gp;
+    gameplay_init(&gp);
+    gameplay_seed(&gp, (Uint32)seed);
+    
+    long long total_ticks = 0;
+    long long total_score = 0;
+    int best_score = 0;
+    int completed = 0;
+    int timed_out = 0;
+    int diverged = 0;
+    int stage_counts[GAMEPLAY_STAGE_COUNT + 1] = {0};
+    
+    Uint64 frequency = SDL_GetPerformanceFrequency();
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int game = 0; game < games; game++) {
+        if (replay_path) {
+            gameplay_seed(&gp, replay.seed);
+        }
+        gameplay_reset_game(&gp);
+        
+        int next_state = GAME_STATE_GAMEPLAY;
+        int tick = 0;
+        GameplayInput input;
+        while (next_state == GAME_STATE_GAMEPLAY && tick < max_ticks) {
+            if (replay_path) {
+                replay_input(&replay, tick, &input);
+            } else if (autoplay) {
+                autoplay_input(&gp, &input);
+            } else {
+                input = *script_input(&script, tick);
+            }
+            gameplay_update(&gp, &input, SIMULATION_STEP, &next_state);
+            tick++;
+        }
+        if (replay_path && (tick != replay.tick_count || gameplay_state_hash(&gp) != replay.end_hash)) {
+            diverged++;
+        }
+    
+        total_ticks += tick;
+        total_score += gp.score;
+        if (gp.score > best_score) best_score = gp.score;
+        if (next_state == GAME_STATE_COMPLETE) completed++;
+        if (next_state == GAME_STATE_GAMEPLAY) timed_out++;
+        stage_counts[gp.stage > GAMEPLAY_STAGE_COUNT ? GAMEPLAY_STAGE_COUNT : gp.stage]++;
+    }
+    double elapsed = (double)(SDL_GetPerformanceCounter() - start) / (double)frequency;
+    
+    gameplay_cleanup(&gp);
+    replay_free(&replay);
+    TRACE_SHUTDOWN();
+    
+    printf("Simulated %d games (%lld ticks, %.1f minutes of play) in %.3f s\n",
+           games, total_ticks, total_ticks / (double)SIMULATION_HZ / 60.0, elapsed);
+    if (elapsed > 0.0) {
+        printf("  %.0f games/s, %.0f ticks/s\n", games / elapsed, total_ticks / elapsed);
+    }
+    if (games > 0) {
+        printf("  score: mean %.1f, best %d\n", (double)total_score / games, best_score);
+    }
+    printf("  completed %d, out of time %d\n", completed, timed_out);
+    if (replay_path) {
+        printf("  replay %s: %d of %d games diverged\n", replay_path, diverged, games);
+    }
+    for (int stage = 1; stage <= GAMEPLAY_STAGE_COUNT; stage++) {
+        printf("  ended on stage %d: %d\n", stage, stage_counts[stage]);
+    }
+    // A computer player that can't finish is a regression in the game or in it
+    return diverged || (autoplay && completed < games) ? 1 : 0;
+}